@@ -0,0 +1,95 @@
+#pragma once
+
+#include <Windows.h>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <vector>
+
+/**
+ * Decides whether a numeric property change is worth reporting.
+ * Policies compare the current value against the last *reported* value,
+ * so a change that is suppressed now is re-evaluated on later refreshes.
+ * Policies are stateful per process and are called under the owning
+ * property's mutex.
+ */
+class ChangePolicy
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    virtual ~ChangePolicy() = default;
+
+    // Return true if moving from lastReported to current should produce an event
+    virtual bool shouldReport(DWORD procId, long long lastReported, long long current, Clock::time_point now) = 0;
+
+    // Called once the value has been reported
+    virtual void onReported(DWORD /*procId*/, long long /*value*/, Clock::time_point /*now*/) {}
+
+    // Forget per-process state (process exited or character changed)
+    virtual void reset(DWORD /*procId*/) {}
+};
+
+// Report every change
+class ExactChangePolicy : public ChangePolicy
+{
+public:
+    bool shouldReport(DWORD procId, long long lastReported, long long current, Clock::time_point now) override;
+};
+
+// Report when the value moved by at least minDelta since the last report
+class DeltaChangePolicy : public ChangePolicy
+{
+private:
+    long long minDelta;
+
+public:
+    explicit DeltaChangePolicy(long long minDelta);
+
+    bool shouldReport(DWORD procId, long long lastReported, long long current, Clock::time_point now) override;
+};
+
+/**
+ * Report when the value crosses into a different band. Bands are delimited
+ * by ascending thresholds (e.g. 1000/2000/3000 TP). Dropping back below a
+ * threshold requires falling hysteresis units under it, so a value hovering
+ * at a threshold does not flap.
+ */
+class BandChangePolicy : public ChangePolicy
+{
+private:
+    std::vector<long long> thresholds;
+    long long hysteresis;
+    std::map<DWORD, size_t> reportedBands;
+
+    size_t bandFor(long long value) const;
+    size_t nextBand(size_t currentBand, long long value) const;
+    size_t reportedBand(DWORD procId, long long lastReported) const;
+
+public:
+    BandChangePolicy(std::vector<long long> thresholds, long long hysteresis = 0);
+
+    bool shouldReport(DWORD procId, long long lastReported, long long current, Clock::time_point now) override;
+    void onReported(DWORD procId, long long value, Clock::time_point now) override;
+    void reset(DWORD procId) override;
+};
+
+/**
+ * Wrap another policy and report at most once per minInterval per process.
+ * A change suppressed by the limit is reported on the first refresh after
+ * the interval elapses (if it still differs from the last reported value).
+ */
+class RateLimitedChangePolicy : public ChangePolicy
+{
+private:
+    std::shared_ptr<ChangePolicy> inner;
+    std::chrono::milliseconds minInterval;
+    std::map<DWORD, Clock::time_point> lastReportTimes;
+
+public:
+    RateLimitedChangePolicy(std::shared_ptr<ChangePolicy> inner, std::chrono::milliseconds minInterval);
+
+    bool shouldReport(DWORD procId, long long lastReported, long long current, Clock::time_point now) override;
+    void onReported(DWORD procId, long long value, Clock::time_point now) override;
+    void reset(DWORD procId) override;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Player/ChatMessage.h"
+#include "helpers/fixedstring.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Chat messages retained between flushes. Each line's raw text is copied
+ * once into a single arena buffer; the message is almost always a slice
+ * of it, so an entry just records where it starts. Senders are cleaned,
+ * stored inline as FixedString and interned, so a busy linkshell keeps
+ * one copy of each name. An entry is 24 bytes (offsets, a sender index,
+ * a one-byte type and a nanosecond timestamp) and appending allocates
+ * only when the arena, the entry list or the sender table grows. Views
+ * handed out by at() are invalidated by the next append().
+ */
+class ChatBatch
+{
+public:
+    using SenderName = FixedString<16>;
+
+    void append(const ChatMessageView& view);
+
+    // Drop the oldest messages so that at most maxMessages remain
+    void trimTo(size_t maxMessages);
+
+    void clear();
+    void swap(ChatBatch& other);
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+
+    ChatMessageView at(size_t index) const;
+    ChatMessage materialize(size_t index) const;
+
+private:
+    static const uint8_t SENT_TELL = 0x01;  // Sender is shown as "You >> Name"
+    static const size_t MAX_SENDERS = 0xFFFF;
+
+    struct Entry {
+        int64_t timestampNs;
+        uint32_t rawOffset;
+        uint16_t rawLength;
+        uint16_t messageStart;   // Relative to rawOffset; past rawLength when the message was stored separately
+        uint16_t messageLength;
+        uint16_t sender;         // Index into senders
+        ChatMessageType type;
+        uint8_t flags;
+
+        uint32_t end() const
+        {
+            uint32_t messageEnd = uint32_t(messageStart) + messageLength;
+            return rawOffset + (messageEnd > rawLength ? messageEnd : rawLength);
+        }
+    };
+
+    std::string arena;
+    std::vector<Entry> entries;
+    std::vector<SenderName> senders;
+    std::unordered_map<SenderName, uint16_t, SenderName::Hash> senderIds;
+    std::string senderScratch;
+
+    uint16_t intern(const SenderName& name);
+    void compact();
+};
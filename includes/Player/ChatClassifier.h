@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Player/ChatMessage.h"
+#include <string_view>
+
+/**
+ * Single-pass chat channel classifier. One scan over the line records
+ * every marker the channel grammar cares about (party parentheses, tell
+ * arrows, linkshell tags, drop/obtain phrases) and a dispatch on the
+ * first non-blank character checks the anchored forms (unity braces,
+ * "Name : ", trial counters). The result is then picked in the same
+ * priority order the old regex list used, extended with the forms the
+ * other chat sources produce ("<Name>" linkshell lines from EliteAPI,
+ * "Name shouts:" in the log file).
+ */
+namespace ChatClassifier {
+
+ChatMessageType classify(std::string_view line);
+
+} // namespace ChatClassifier
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Player/ChatMessage.h"
+#include "helpers/fixedstring.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * One forwarding rule. A line matches when its channel is in channels,
+ * its sender is one of senders (any sender if empty) and its message
+ * contains one of keywords (any message if empty and mentionsCharacter
+ * is off). Senders and keywords compare ASCII case-insensitively.
+ */
+struct ChatSubscription {
+    uint32_t channels = 0;                 // channelBit() of each accepted ChatMessageType
+    std::vector<std::string> senders;
+    std::vector<std::string> keywords;
+    bool mentionsCharacter = false;        // Our character names count as keywords
+
+    static uint32_t channelBit(ChatMessageType type) {
+        return type == ChatMessageType::Unknown ? 0 : (1u << static_cast<uint32_t>(type));
+    }
+};
+
+/**
+ * All active subscriptions compiled into lookup tables: a subscription
+ * mask per channel, a hash of sender names to masks, and one
+ * Aho-Corasick automaton over every keyword. A line is checked with two
+ * mask lookups and, only if some subscription still needs a keyword, a
+ * single pass over the message with one table step per byte, however
+ * many patterns are loaded. The automaton's bytes are folded into the
+ * classes that occur in patterns, so its table stays small with
+ * thousands of keywords.
+ *
+ * An empty filter (no subscriptions) accepts every line of a known
+ * channel, which is what was forwarded before filtering existed.
+ */
+class ChatFilter
+{
+public:
+    static const size_t MAX_SUBSCRIPTIONS = 64;
+
+    // Replace the compiled rules; subscriptions past MAX_SUBSCRIPTIONS are
+    // ignored and make this return false
+    bool compile(const std::vector<ChatSubscription>& subscriptions, const std::vector<std::string>& characterNames);
+
+    bool matches(const ChatMessageView& msg) const;
+
+    bool empty() const { return subscriptionCount == 0; }
+    size_t patternCount() const { return patterns; }
+    size_t stateCount() const { return outputs.size(); }
+
+private:
+    using SenderKey = FixedString<16>;
+    static const size_t CHANNEL_COUNT = 32;
+
+    size_t subscriptionCount = 0;
+    size_t patterns = 0;
+
+    uint64_t channelSubscriptions[CHANNEL_COUNT] = {};
+    uint64_t anySender = 0;        // Subscriptions without a sender list
+    uint64_t needsKeyword = 0;     // Subscriptions with a keyword list
+    std::unordered_map<SenderKey, uint64_t, SenderKey::Hash> senderSubscriptions;
+
+    // Automaton: state * classCount + byteClass[byte] -> next state;
+    // outputs[state] is every subscription with a keyword ending there
+    uint8_t byteClass[256] = {};
+    size_t classCount = 1;
+    std::vector<uint32_t> transitions;
+    std::vector<uint64_t> outputs;
+
+    static SenderKey senderKey(std::string_view name);
+    void buildAutomaton(const std::vector<std::pair<std::string, uint64_t>>& keywords);
+    // Subscriptions in wanted with a keyword in text; stops at the first hit
+    uint64_t scan(std::string_view text, uint64_t wanted) const;
+};
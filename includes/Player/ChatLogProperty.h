@@ -6,7 +6,7 @@
 #include <functional>
 #include <map>
 #include <string>
-#include <regex>
+#include <string_view>
 
 // Forward declarations
 struct PlayerProcessInfo;
@@ -15,7 +15,7 @@ struct PlayerProcessInfo;
 class ChatLogProperty
 {
 public:
-    using ChatCallback = std::function<void(DWORD procId, const ChatMessage&)>;
+    using ChatCallback = std::function<void(DWORD procId, const ChatMessageView&)>;
 
     ChatLogProperty();
 
@@ -30,30 +30,30 @@ private:
     // Chat buffer memory address: FFXiMain.dll + 0x00128AD4 + 0x00 (base pointer has full message)
     static const DWORD CHAT_LOG_BASE = 0x00128AD4;
     static const DWORD CHAT_LOG_OFFSET = 0x00;  // Changed from 0x10 - base pointer contains complete messages
-    static const int CHAT_BUFFER_SIZE = 4096; // Size to read
+    static const int CHAT_BUFFER_SIZE = 4096; // Largest line read
+    static const int PROBE_SIZE = 64;         // First cache line, read every refresh
+
+    // Where each process's buffer was and what its first cache line hashed to last time;
+    // an unchanged probe skips the rest of the refresh
+    struct ChatCursor {
+        uintptr_t address = 0;
+        uint64_t probeHash = 0;
+    };
+    std::map<DWORD, ChatCursor> cursors;
 
     // Track last chat content per process to detect changes
     std::map<DWORD, std::string> lastChatContent;
 
-    // Chat callback
-    ChatCallback chatCallback;
-
-    // Regex patterns for chat type detection (Lua patterns converted to C++ regex)
-    struct ChatPattern {
-        std::regex pattern;
-        ChatMessageType type;
-    };
-    std::vector<ChatPattern> chatPatterns;
-
-    // Initialize regex patterns
-    void initializePatterns();
+    // Raw bytes of the current line, read only as far as its terminator
+    std::string rawBuffer;
 
-    // Parse chat line and determine type
-    ChatMessage ParseChatLine(const std::string& line);
+    // Control-code-free copy of the current buffer; parsed views point into it
+    std::string cleanedBuffer;
 
-    // Extract message type from line using regex patterns
-    ChatMessageType DetermineChatType(const std::string& line);
+    // Chat callback
+    ChatCallback chatCallback;
 
-    // Helper to remove FFXI special characters from strings
-    std::string CleanFFXIString(const std::string& input);
+    // Read the line at address into rawBuffer, continuing from the probe in growing
+    // chunks until the terminator; false if a read fails
+    bool ReadChatLine(HANDLE hProcess, uintptr_t address, const char* probe, size_t& length);
 };
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "helpers/ffxitext.h"
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <ctime>
 
-enum class ChatMessageType {
+enum class ChatMessageType : uint8_t {
     Say = 0,
     Shout = 1,
     Tell = 2,
@@ -20,6 +23,25 @@ enum class ChatMessageType {
     Unknown = 99
 };
 
+inline const char* getChatMessageTypeString(ChatMessageType type) {
+    switch (type) {
+        case ChatMessageType::Say: return "SAY";
+        case ChatMessageType::Shout: return "SHOUT";
+        case ChatMessageType::Tell: return "TELL";
+        case ChatMessageType::Party: return "PARTY";
+        case ChatMessageType::Linkshell1: return "LINKSHELL1";
+        case ChatMessageType::Linkshell2: return "LINKSHELL2";
+        case ChatMessageType::Yell: return "YELL";
+        case ChatMessageType::Unity: return "UNITY";
+        case ChatMessageType::Drops: return "DROPS";
+        case ChatMessageType::Obtained: return "OBTAINED";
+        case ChatMessageType::Trial: return "TRIAL";
+        case ChatMessageType::System: return "SYSTEM";
+        case ChatMessageType::Emote: return "EMOTE";
+        default: return "UNKNOWN";
+    }
+}
+
 struct ChatMessage {
     std::string message;
     std::string sender;
@@ -28,21 +50,42 @@ struct ChatMessage {
     std::time_t timestamp;
 
     std::string getMessageTypeString() const {
-        switch (type) {
-            case ChatMessageType::Say: return "SAY";
-            case ChatMessageType::Shout: return "SHOUT";
-            case ChatMessageType::Tell: return "TELL";
-            case ChatMessageType::Party: return "PARTY";
-            case ChatMessageType::Linkshell1: return "LINKSHELL1";
-            case ChatMessageType::Linkshell2: return "LINKSHELL2";
-            case ChatMessageType::Yell: return "YELL";
-            case ChatMessageType::Unity: return "UNITY";
-            case ChatMessageType::Drops: return "DROPS";
-            case ChatMessageType::Obtained: return "OBTAINED";
-            case ChatMessageType::Trial: return "TRIAL";
-            case ChatMessageType::System: return "SYSTEM";
-            case ChatMessageType::Emote: return "EMOTE";
-            default: return "UNKNOWN";
-        }
+        return getChatMessageTypeString(type);
+    }
+};
+
+/**
+ * A parsed chat line that does not own its text: every field points into
+ * the buffer the line was parsed from (or at a string literal), so
+ * parsing allocates nothing. Views are only valid while that buffer is;
+ * anything that keeps a message copies it into a ChatBatch or calls
+ * materialize().
+ */
+struct ChatMessageView {
+    std::string_view message;
+    std::string_view senderPrefix;  // "You >> " for sent tells, empty otherwise
+    std::string_view sender;        // May still contain FFXI control bytes; cleaned when copied
+    std::string_view rawContent;
+    ChatMessageType type = ChatMessageType::Unknown;
+    int64_t timestampNs = 0;        // Nanoseconds since the Unix epoch
+
+    const char* getMessageTypeString() const {
+        return getChatMessageTypeString(type);
+    }
+
+    std::time_t timestamp() const {
+        return static_cast<std::time_t>(timestampNs / 1000000000);
+    }
+
+    // Owning copy (sender cleaned to printable ASCII)
+    ChatMessage materialize() const {
+        ChatMessage msg;
+        msg.message.assign(message.data(), message.size());
+        msg.sender.assign(senderPrefix.data(), senderPrefix.size());
+        FFXIText::decode(sender, FFXIText::Profile::Printable, msg.sender);
+        msg.rawContent.assign(rawContent.data(), rawContent.size());
+        msg.type = type;
+        msg.timestamp = timestamp();
+        return msg;
     }
 };
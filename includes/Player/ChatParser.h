@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Player/ChatMessage.h"
+#include <string_view>
+
+/**
+ * The chat parser shared by every chat source (memory reader, EliteAPI,
+ * log file). Sources strip their own framing (control codes via
+ * FFXIText, timestamps, log prefixes) and hand over one line of text;
+ * the channel comes from ChatClassifier and sender and message are
+ * sliced out of the line, so the result points into it and parsing
+ * allocates nothing. Lines with no sender are returned as System
+ * messages carrying the whole line.
+ */
+namespace ChatParser {
+
+ChatMessageView parse(std::string_view line);
+
+} // namespace ChatParser
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Player/Player.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * A property computed from other registered properties, e.g.
+ * "weapon skill ready" = TP >= 1000 && !casting.
+ *
+ * Register with Player::registerDerivedProperty() after all of its inputs;
+ * the monitoring loop then evaluates derived properties in dependency order.
+ * refresh() recomputes only when an input's version changed, so inputs
+ * registered with publishChanges = false cost nothing upstream and only
+ * derived changes are published.
+ */
+class DerivedProperty : public PlayerProperty {
+public:
+    using ComputeFunc = std::function<long long(DWORD procId, const std::vector<long long>& inputs)>;
+
+    DerivedProperty(const std::string& name,
+                    std::vector<std::shared_ptr<PlayerProperty>> inputs,
+                    ComputeFunc compute,
+                    const std::string& endpoint);
+
+    // Implementation of base class abstract methods
+    virtual void refresh(const PlayerProcessInfo& process) override;
+    virtual const char* getPropertyName() const override;
+    virtual void displayValue(DWORD procId) const override;
+
+    // Change detection implementation
+    virtual bool hasChanged(DWORD procId) const override;
+    virtual void acknowledgeChange(DWORD procId) override;
+    virtual void reportChange(DWORD procId) const override;
+
+    virtual long long getNumericValue(DWORD procId) const override;
+
+    const std::vector<std::shared_ptr<PlayerProperty>>& getInputs() const;
+
+private:
+    std::string name;
+    std::string endpoint;
+    std::vector<std::shared_ptr<PlayerProperty>> inputs;
+    ComputeFunc compute;
+
+    // Computed values and the input versions they were computed from
+    std::map<DWORD, long long> values;
+    std::map<DWORD, std::vector<uint64_t>> inputVersions;
+};
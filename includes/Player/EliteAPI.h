@@ -55,8 +55,8 @@ public:
      */
     void Cleanup();
 
-    // Chat monitoring methods
-    using ChatCallback = std::function<void(const ChatMessage&)>;
+    // Chat monitoring methods; the view is only valid during the callback
+    using ChatCallback = std::function<void(const ChatMessageView&)>;
 
     /**
      * Register a callback function to be called when chat messages are received
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Windows.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Client entity layout shared by everything that reads entities
+ * (entity table, target, position). The client is 32-bit, so entity
+ * pointers are 4 bytes.
+ */
+namespace EntityLayout {
+
+// Entity pointer array, relative to FFXiMain.dll
+static const DWORD ENTITY_ARRAY_OFFSET = 0x004A8C40;
+static const std::vector<unsigned int> ENTITY_ARRAY_OFFSETS = {0x00};
+static const size_t MAX_ENTITIES = 2304;
+
+// Field offsets inside an entity
+static const uint32_t READ_SIZE = 0x180;    // Prefix of the entity that holds every field below
+static const uint32_t POS_X = 0x04;
+static const uint32_t POS_Z = 0x08;
+static const uint32_t POS_Y = 0x0C;
+static const uint32_t HEADING = 0x18;
+static const uint32_t SERVER_ID = 0x78;
+static const uint32_t NAME = 0x7C;
+static const uint32_t NAME_LENGTH = 24;
+static const uint32_t SPEED = 0x98;
+static const uint32_t DISTANCE = 0xD8;      // Squared distance to the local player
+static const uint32_t HPP = 0xEC;
+static const uint32_t STATUS = 0x16C;
+static const uint32_t TYPE = 0x170;
+static const uint32_t CLAIM_ID = 0x174;     // Server ID of the claiming player, 0 if unclaimed
+
+} // namespace EntityLayout
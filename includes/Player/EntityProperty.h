@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Player/Player.h"
+#include "Player/EntityLayout.h"
+#include "helpers/memory.h"
+#include "helpers/bitset.h"
+#include "helpers/spatialgrid.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Bulk reader for the client's entity array (players, NPCs, mobs). The
+ * pointer array is read in one call, the live entities are sorted by
+ * address and read back in coalesced ranges, and the fields we care
+ * about are transposed into struct-of-arrays columns. A uniform grid
+ * over X/Y answers "who is near this character" without scanning all
+ * slots; it is only touched for entities whose position changed.
+ */
+class EntityProperty : public PlayerProperty {
+public:
+    static const size_t MAX_ENTITIES = EntityLayout::MAX_ENTITIES;
+    using EntityMask = FixedBitset<MAX_ENTITIES>;
+
+    // Matches EliteMMO.API.EntityTypes
+    enum class EntityType : uint8_t {
+        Player = 0,
+        Npc1 = 1,
+        Npc2 = 2,
+        Npc3 = 3,
+        Elevator = 4,
+        Airship = 5
+    };
+
+    // Row view of one entity, materialised for query results
+    struct EntityInfo {
+        uint16_t index;
+        uint32_t serverId;
+        std::string name;
+        float x, y, z;
+        uint8_t hpp;
+        uint8_t status;   // EliteMMO.API.EntityStatus
+        uint8_t type;     // EntityType
+        float distance;   // From the query origin
+    };
+
+    EntityProperty();
+
+    // Implementation of base class abstract methods
+    virtual void refresh(const PlayerProcessInfo& process) override;
+    virtual const char* getPropertyName() const override;
+    virtual void displayValue(DWORD procId) const override;
+
+    // Change detection implementation (membership of the nearby set, not movement)
+    virtual bool hasChanged(DWORD procId) const override;
+    virtual void acknowledgeChange(DWORD procId) override;
+    virtual void reportChange(DWORD procId) const override;
+    virtual void onIdentityChanged(DWORD procId) override;
+
+    // Number of entities within NEARBY_RADIUS of the character
+    virtual long long getNumericValue(DWORD procId) const override;
+
+    /**
+     * Entities within radius of the character, closest first
+     * @param typeMask Bit n set = include EntityType n (default: all)
+     */
+    std::vector<EntityInfo> getNearby(DWORD procId, float radius, uint32_t typeMask = 0xFFFFFFFF) const;
+
+    /**
+     * The k entities closest to the character, closest first
+     */
+    std::vector<EntityInfo> getNearest(DWORD procId, size_t k) const;
+
+    size_t getEntityCount(DWORD procId) const;
+
+private:
+    // Coalescing limits for the range reads
+    static const uint32_t MAX_GAP_BYTES = 0x400;       // Read through small gaps instead of splitting
+    static const uint32_t MAX_BATCH_BYTES = 0x10000;   // Upper bound on a single read
+
+    static const float GRID_CELL_SIZE;
+    static const float NEARBY_RADIUS;
+    static const std::string API_ENDPOINT;
+
+    // Struct-of-arrays entity table, one per character
+    struct EntityTable {
+        EntityMask valid;
+        std::vector<uint32_t> pointers;
+        std::vector<uint32_t> serverIds;
+        std::vector<uint32_t> nameOffsets;   // Into namePool
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+        std::vector<uint8_t> hpp;
+        std::vector<uint8_t> status;
+        std::vector<uint8_t> type;
+        std::vector<char> namePool;          // NUL-terminated names, appended on spawn
+        SpatialGrid grid;
+        int selfIndex = -1;
+
+        std::vector<uint32_t> nearby;          // Sorted server IDs within NEARBY_RADIUS
+        std::vector<uint32_t> reportedNearby;
+
+        EntityTable();
+    };
+
+    std::map<DWORD, EntityTable> tables;
+
+    EntityInfo makeInfo(const EntityTable& table, uint32_t index, float originX, float originY) const;
+    void compactNames(EntityTable& table) const;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Player/Player.h"
+#include "helpers/memory.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+
+/**
+ * Zone and weather per character. The zone ID is a single 2-byte read
+ * per tick; weather is only read when a character changes zone, and the
+ * result is cached per zone so every character standing in that zone
+ * shares it. Cached weather expires after one Vana'diel hour, the
+ * shortest interval at which the game changes it.
+ */
+class EnvironmentProperty : public PlayerProperty {
+public:
+    EnvironmentProperty();
+
+    // Implementation of base class abstract methods
+    virtual void refresh(const PlayerProcessInfo& process) override;
+    virtual const char* getPropertyName() const override;
+    virtual void displayValue(DWORD procId) const override;
+
+    // Change detection implementation
+    virtual bool hasChanged(DWORD procId) const override;
+    virtual void acknowledgeChange(DWORD procId) override;
+    virtual void reportChange(DWORD procId) const override;
+    virtual void onIdentityChanged(DWORD procId) override;
+
+    // Zone ID of the character (0 if unknown)
+    virtual long long getNumericValue(DWORD procId) const override;
+
+    uint16_t getZone(DWORD procId) const;
+    int getWeather(DWORD procId) const;  // EliteMMO.API.Weather, -1 if unknown
+
+    // Weather reads actually issued, for diagnostics
+    uint64_t getWeatherReadCount() const;
+
+private:
+    DWORD zoneBaseOffset = 0x004A2B60;
+    std::vector<unsigned int> zoneOffsets = {0x00};
+    DWORD weatherBaseOffset = 0x004A3F20;
+    std::vector<unsigned int> weatherOffsets = {0x00};
+
+    static const std::string API_ENDPOINT;
+
+    struct WeatherEntry {
+        int weather = -1;
+        std::chrono::steady_clock::time_point readAt;
+    };
+
+    struct EnvironmentState {
+        uint16_t zone = 0;
+        int weather = -1;
+        uint16_t reportedZone = 0;
+        int reportedWeather = -1;
+    };
+
+    std::map<uint16_t, WeatherEntry> weatherByZone;
+    std::map<DWORD, EnvironmentState> states;
+    uint64_t weatherReads = 0;
+
+    bool readWeather(const PlayerProcessInfo& process, int& weather) const;
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Player/Player.h"
+#include "helpers/memory.h"
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Cross-character inventory index. Every StorageContainer (inventory,
+ * safes, storage, locker, satchel, sack, case, wardrobes) is read with
+ * one range read per container at a slow tier and diffed slot by slot
+ * against the previous snapshot; only slots that actually changed touch
+ * the inverted index (item ID -> every character/container/slot holding
+ * it). Entries are keyed by character ID and survive logout, so mules
+ * remain searchable while they are not logged in.
+ */
+class InventoryProperty : public PlayerProperty {
+public:
+    // Matches EliteMMO.API.StorageContainer
+    enum class Container : uint8_t {
+        Inventory = 0,
+        Safe = 1,
+        Storage = 2,
+        Temporary = 3,
+        Locker = 4,
+        Satchel = 5,
+        Sack = 6,
+        Case = 7,
+        Wardrobe = 8,
+        Safe2 = 9,
+        Wardrobe2 = 10,
+        Wardrobe3 = 11,
+        Wardrobe4 = 12,
+        Count
+    };
+
+    static const size_t CONTAINER_COUNT = static_cast<size_t>(Container::Count);
+    static const size_t SLOTS_PER_CONTAINER = 81;  // Slot 0 of the inventory is gil
+
+    struct ItemLocation {
+        DWORD characterId;
+        uint8_t container;
+        uint8_t slot;
+        uint32_t count;
+    };
+
+    struct SlotChange {
+        uint8_t container;
+        uint8_t slot;
+        uint16_t itemId;   // 0 = emptied
+        uint32_t count;
+    };
+
+    InventoryProperty();
+
+    // Implementation of base class abstract methods
+    virtual void refresh(const PlayerProcessInfo& process) override;
+    virtual const char* getPropertyName() const override;
+    virtual void displayValue(DWORD procId) const override;
+
+    // Change detection implementation
+    virtual bool hasChanged(DWORD procId) const override;
+    virtual void acknowledgeChange(DWORD procId) override;
+    virtual void reportChange(DWORD procId) const override;
+    virtual void onIdentityChanged(DWORD procId) override;
+
+    // Cross-character queries
+    std::vector<ItemLocation> findItem(uint16_t itemId) const;
+    uint64_t totalCount(uint16_t itemId) const;
+    uint64_t countFor(DWORD characterId, uint16_t itemId) const;
+    std::vector<DWORD> whoHas(uint16_t itemId) const;
+
+    static const char* getContainerName(Container container);
+
+private:
+    // Item containers, relative to FFXiMain.dll; containers are laid out back to back
+    DWORD containerBaseOffset = 0x004A0C98;
+    std::vector<unsigned int> containerOffsets = {0x00};
+    static const uint32_t CONTAINER_STRIDE = 0x0DF0;
+
+    static const std::string API_ENDPOINT;
+
+#pragma pack(push, 1)
+    struct RawItem {
+        uint16_t id;
+        uint16_t index;
+        uint32_t count;
+        uint32_t flags;
+        uint32_t price;
+        uint8_t extra[28];
+    };
+#pragma pack(pop)
+    static_assert(sizeof(RawItem) == 0x2C, "Item stride must match the client");
+
+    struct SlotState {
+        uint16_t itemId = 0;
+        uint32_t count = 0;
+    };
+
+    using ContainerSnapshot = std::array<SlotState, SLOTS_PER_CONTAINER>;
+
+    struct CharacterInventory {
+        std::array<ContainerSnapshot, CONTAINER_COUNT> containers{};
+        bool loaded = false;
+    };
+
+    // Per character (not per process) so logged-out mules stay indexed
+    std::map<DWORD, CharacterInventory> characters;
+
+    // Which character each process is currently logged in as
+    std::map<DWORD, DWORD> processCharacters;
+
+    // Slot changes not yet reported, per process
+    std::map<DWORD, std::vector<SlotChange>> pendingChanges;
+    std::map<DWORD, bool> pendingFullSnapshot;
+
+    // Inverted index: item ID -> locations
+    std::unordered_map<uint16_t, std::vector<ItemLocation>> itemIndex;
+
+    void indexAdd(DWORD characterId, uint8_t container, uint8_t slot, uint16_t itemId, uint32_t count);
+    void indexRemove(DWORD characterId, uint8_t container, uint8_t slot, uint16_t itemId);
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Player/Player.h"
+#include "helpers/memory.h"
+#include "helpers/bitset.h"
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/**
+ * Bulk ownership tracker for key items, spells, abilities, traits and
+ * weapon skills. Instead of one HasKeyItem/HasSpell/... DLL call per ID,
+ * each ownership table is pulled with a single range read into a packed
+ * bitset per character. Meant for a slow tier (tens of seconds); diffs
+ * against the last report produce "obtained"/"learned" events, and
+ * cross-character queries run as SIMD AND/OR over the stacked bitsets.
+ */
+class OwnershipProperty : public PlayerProperty {
+public:
+    enum class Category {
+        KeyItems = 0,
+        Spells,
+        Abilities,
+        Traits,
+        WeaponSkills,
+        Count
+    };
+
+    static const size_t CATEGORY_COUNT = static_cast<size_t>(Category::Count);
+    static const size_t MAX_OWNERSHIP_ID = 4096;
+    using OwnershipSet = FixedBitset<MAX_OWNERSHIP_ID>;
+
+    OwnershipProperty();
+
+    // Implementation of base class abstract methods
+    virtual void refresh(const PlayerProcessInfo& process) override;
+    virtual const char* getPropertyName() const override;
+    virtual void displayValue(DWORD procId) const override;
+
+    // Change detection implementation
+    virtual bool hasChanged(DWORD procId) const override;
+    virtual void acknowledgeChange(DWORD procId) override;
+    virtual void reportChange(DWORD procId) const override;
+    virtual void onIdentityChanged(DWORD procId) override;
+
+    // Per-character queries
+    bool has(DWORD procId, Category category, uint16_t id) const;
+    OwnershipSet getSet(DWORD procId, Category category) const;
+
+    // Cross-character queries
+    std::vector<DWORD> whoHas(Category category, uint16_t id) const;
+    OwnershipSet ownedByAll(Category category) const;  // AND over every character
+    OwnershipSet ownedByAny(Category category) const;  // OR over every character
+    OwnershipSet missingFrom(DWORD procId, Category category) const; // Owned by someone else but not procId
+
+    static const char* getCategoryName(Category category);
+
+private:
+    struct TableLayout {
+        DWORD baseOffset;
+        std::vector<unsigned int> offsets;
+        size_t byteSize;  // Packed bits, LSB first
+    };
+
+    // Ownership tables, relative to FFXiMain.dll
+    static const TableLayout TABLE_LAYOUTS[CATEGORY_COUNT];
+
+    static const std::string API_ENDPOINT;
+
+    struct OwnershipState {
+        OwnershipSet current[CATEGORY_COUNT];
+        OwnershipSet reported[CATEGORY_COUNT];
+        bool loaded = false;
+    };
+
+    std::map<DWORD, OwnershipState> states;
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Player/Player.h"
+#include "helpers/memory.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+/**
+ * Party/alliance state shared across boxed clients. Clients in the same
+ * alliance see identical party data, so instead of every client reading
+ * the full member table, each client only reads the 16-byte alliance
+ * header (leader IDs) to work out which party it belongs to. One client
+ * per party is elected reader and fills a shared struct-of-arrays
+ * snapshot; the others are served from it. If the reader stops producing
+ * reads (zoning, logged out, process gone) another member takes over.
+ */
+class PartyProperty : public PlayerProperty {
+public:
+    static const size_t MAX_MEMBERS = 18; // Full alliance
+
+    // Identifies an alliance/party: the same on every client in it
+    struct PartyKey {
+        uint32_t allianceLeaderId;
+        uint32_t partyLeaderIds[3];
+
+        bool operator<(const PartyKey& other) const;
+        bool operator==(const PartyKey& other) const;
+    };
+
+    // Struct-of-arrays snapshot of one party/alliance
+    struct PartySnapshot {
+        std::array<uint32_t, MAX_MEMBERS> serverIds{};
+        std::array<uint32_t, MAX_MEMBERS> hp{};
+        std::array<uint32_t, MAX_MEMBERS> mp{};
+        std::array<uint32_t, MAX_MEMBERS> tp{};
+        std::array<uint8_t, MAX_MEMBERS> hpp{};
+        std::array<uint8_t, MAX_MEMBERS> mpp{};
+        std::array<uint16_t, MAX_MEMBERS> zones{};
+        std::array<std::array<char, 16>, MAX_MEMBERS> names{};
+        uint32_t activeMask = 0;   // Bit n set = slot n occupied
+
+        DWORD readerProcId = 0;    // Elected client
+        std::chrono::steady_clock::time_point lastRead;
+        uint64_t version = 0;
+    };
+
+    PartyProperty();
+
+    // Implementation of base class abstract methods
+    virtual void refresh(const PlayerProcessInfo& process) override;
+    virtual const char* getPropertyName() const override;
+    virtual void displayValue(DWORD procId) const override;
+
+    // Change detection implementation (only the elected reader reports)
+    virtual bool hasChanged(DWORD procId) const override;
+    virtual void acknowledgeChange(DWORD procId) override;
+    virtual void reportChange(DWORD procId) const override;
+    virtual void onIdentityChanged(DWORD procId) override;
+
+    // Snapshot of the party the process belongs to (false if unknown)
+    bool getSnapshot(DWORD procId, PartySnapshot& out) const;
+
+    // Lowest HP% among active members of the process's party (100 if unknown)
+    long long getLowestHpp(DWORD procId) const;
+    virtual long long getNumericValue(DWORD procId) const override;
+
+    // Number of distinct parties and reads performed/skipped, for diagnostics
+    size_t getPartyCount() const;
+    uint64_t getFullReadCount() const;
+    uint64_t getSharedServeCount() const;
+
+private:
+    // Alliance header: alliance leader then the three party leaders
+    DWORD allianceBaseOffset = 0x004A2B08;
+    std::vector<unsigned int> allianceOffsets = {0x00};
+
+    // Member table: MAX_MEMBERS entries of RawPartyMember
+    DWORD partyBaseOffset = 0x004A2B08;
+    std::vector<unsigned int> partyOffsets = {0x2C};
+
+    // Reader considered gone after this long without a successful read
+    static const int READER_TIMEOUT_MS = 1500;
+
+    static const std::string API_ENDPOINT;
+
+#pragma pack(push, 1)
+    struct RawPartyMember {
+        uint32_t unknown00;
+        uint8_t index;
+        uint8_t memberNumber;
+        char name[18];
+        uint32_t serverId;
+        uint32_t targetIndex;
+        uint32_t unknown20;
+        uint32_t hp;
+        uint32_t mp;
+        uint32_t tp;
+        uint8_t hpp;
+        uint8_t mpp;
+        uint16_t zone;
+        uint8_t unknown34[0x44];
+        uint32_t active;
+    };
+#pragma pack(pop)
+    static_assert(sizeof(RawPartyMember) == 0x7C, "Party member stride must match the client");
+
+    std::map<PartyKey, PartySnapshot> parties;
+    std::map<DWORD, PartyKey> processParties;        // Which party each process is in
+    std::map<DWORD, uint64_t> reportedVersions;      // Last reported snapshot version per reader
+    uint64_t fullReads = 0;
+    uint64_t sharedServes = 0;
+
+    bool readPartyKey(const PlayerProcessInfo& process, PartyKey& key) const;
+    bool readMembers(const PlayerProcessInfo& process, PartySnapshot& snapshot) const;
+    void pruneParties();  // Drop snapshots no process belongs to; propertyMutex held
+};
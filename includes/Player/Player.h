@@ -12,10 +12,20 @@
 #include <deque>
 #include "memory.h"
 #include "Player/ChatMessage.h"
+#include "Player/ChatBatch.h"
+#include "Player/ChatFilter.h"
+#include "Player/PropertyRegistry.h"
+#include "Player/ChangePolicy.h"
+#include "helpers/fixedstring.h"
+#include "helpers/publisher.h"
+#include "helpers/resourcetable.h"
+#include "helpers/vanaclock.h"
 
 // Forward declarations for property classes
 class PlayerProperty;
+class DerivedProperty;
 class ChatLogProperty;
+class RecastProperty;
 class EliteAPI;
 
 // Core player data structure
@@ -39,13 +49,22 @@ private:
         std::shared_ptr<PlayerProperty> property;
         unsigned int monitoringIntervalMs;
         std::chrono::steady_clock::time_point lastUpdateTime;
+        bool publishChanges; // false = input-only (e.g. feeds a derived property)
     };
 
     std::vector<PropertyConfig> propertyConfigs;
+    PropertyRegistry propertyRegistry; // O(1) lookup of propertyConfigs by type or name
+    PropertyHandle<RecastProperty> recastProperty; // Resolved at registration; chat lines ask it to resync
+
+    // Append a property config and bind it in the registry; returns its slot
+    size_t addPropertyConfig(std::shared_ptr<PlayerProperty> property, unsigned int intervalMs, PropertyTypeId typeId, bool publishChanges);
 
     // Static properties (read once, don't change during gameplay)
-    std::map<DWORD, std::string> playerNames;
+    std::map<DWORD, std::string> playerNames; // Guarded by playerNameMutex
+    std::map<DWORD, FixedString<16>> actorNames; // Known names only, for matching chat lines without copies (guarded by playerNameMutex)
+    mutable std::mutex playerNameMutex; // Held only around the two name maps; no other lock is taken under it
     std::map<DWORD, DWORD> playerIds;
+    std::map<DWORD, DWORD> lastKnownPlayerIds; // Last non-zero ID per process; switches are judged against it
 
     // Static property memory addresses
     static const DWORD PLAYER_NAME_OFFSET_BASE = 0x004DBA94;
@@ -61,19 +80,36 @@ private:
     std::mutex processMutex;
     unsigned int defaultMonitoringIntervalMs = 100; // Default check every 100ms
 
+    // Property change publishing (keeps HTTP off the monitoring thread)
+    ChangePublisher changePublisher;
+
+    // Static game data (item/spell/ability/zone names), memory-mapped at startup
+    ResourceTables resources;
+    static const char* RESOURCE_FILE;
+
+    // Vana'diel time, computed locally and verified once against a client
+    VanaClock vanaClock;
+    static const DWORD VANA_TIME_OFFSET_BASE = 0x004A3F18;
+    static const std::vector<unsigned int> VANA_TIME_OFFSETS;
+
     // Chat monitoring
     std::shared_ptr<ChatLogProperty> chatLogProperty; // Chat log property for memory reading (legacy)
     std::map<DWORD, std::shared_ptr<EliteAPI>> eliteAPIInstances; // Elite API instances per process
-    std::map<DWORD, std::deque<ChatMessage>> processChats;
+    std::map<DWORD, ChatBatch> processChats; // Pending batch per process, flushed by the debounce thread
+    std::vector<ChatSubscription> chatSubscriptions; // Forwarding rules; empty forwards every known channel
+    ChatFilter chatFilter; // chatSubscriptions compiled against the current character names (guarded by chatMutex)
     std::mutex chatMutex;
+    std::mutex chatFilterBuildMutex; // Serializes rebuildChatFilter() so an older build can't replace a newer one
     bool chatMonitoringEnabled;
     std::map<DWORD, std::chrono::steady_clock::time_point> lastChatTime;
     std::map<DWORD, std::thread> chatDebounceThreads;
     std::map<DWORD, bool> debounceThreadRunning; // Track if debounce thread is active
     std::atomic<bool> shutdownChatMonitoring;
 
-    void onChatMessage(DWORD procId, const ChatMessage& msg);
-    void sendChatBatch(DWORD procId, const std::vector<ChatMessage>& messages);
+    void onChatMessage(DWORD procId, const ChatMessageView& msg);
+    void rebuildChatFilter();
+    void storePlayerName(DWORD procId, const std::string& name);
+    void sendChatBatch(DWORD procId, const ChatBatch& messages);
     void chatDebounceThread(DWORD procId);
 
     // Process initialization
@@ -87,9 +123,18 @@ private:
 
     // Static property reading
     void readStaticProperties();
-    void readPlayerName(const PlayerProcessInfo& process);
+    void readPlayerName(const PlayerProcessInfo& process); // Rebuilds the chat filter when the name changes
+    void readPlayerNameFromMemory(const PlayerProcessInfo& process);
     void readPlayerId(const PlayerProcessInfo& process);
 
+    // Character switch detection (logout/login on the same pol.exe)
+    DWORD readPlayerIdSentinel(const PlayerProcessInfo& process) const;
+    void checkForCharacterSwitches();
+    void onCharacterSwitch(const PlayerProcessInfo& process, DWORD newPlayerId);
+
+    // One raw Vana'diel time read to check the local clock after attach
+    void verifyVanaClock(const PlayerProcessInfo& process);
+
     // Thread function for continuous monitoring
     void monitorPropertiesThread();
 
@@ -100,7 +145,32 @@ public:
     // Process management
     std::vector<DWORD> getProcessIds() const;
     bool isValidProcess(DWORD procId) const;    // Property management
-    void registerProperty(std::shared_ptr<PlayerProperty> property, unsigned int intervalMs = 0);
+    void registerProperty(std::shared_ptr<PlayerProperty> property, unsigned int intervalMs = 0, bool publishChanges = true);
+
+    // Register a property and get a typed handle to it (also findable via findProperty<T>())
+    template <typename T>
+    PropertyHandle<T> registerProperty(std::shared_ptr<T> property, unsigned int intervalMs = 0, bool publishChanges = true)
+    {
+        addPropertyConfig(property, intervalMs, propertyTypeId<T>(), publishChanges);
+        return PropertyHandle<T>(property.get());
+    }
+
+    // Register a derived property; all of its inputs must already be registered,
+    // which keeps the monitoring loop's evaluation order topological
+    bool registerDerivedProperty(std::shared_ptr<DerivedProperty> property, unsigned int intervalMs = 0);
+
+    // Resolve a typed handle in O(1); resolve once and reuse in hot paths
+    template <typename T>
+    PropertyHandle<T> findProperty() const
+    {
+        size_t slot = propertyRegistry.findByType(propertyTypeId<T>());
+        if (slot == PropertyRegistry::npos)
+        {
+            return PropertyHandle<T>();
+        }
+        return PropertyHandle<T>(static_cast<T*>(propertyConfigs[slot].property.get()));
+    }
+
     void setPropertyRefreshInterval(const char* propertyName, unsigned int intervalMs);
     void refreshAllProperties();
     void refreshProperty(const char* propertyName);
@@ -112,6 +182,15 @@ public:
     void setMonitoringInterval(unsigned int intervalMs);
     bool isMonitoring() const;
 
+    // Change publisher used by properties in reportChange()
+    ChangePublisher& getChangePublisher();
+
+    // Static game data; check isOpen() before relying on lookups
+    const ResourceTables& getResources() const;
+
+    // Vana'diel clock shared by all characters (no memory reads)
+    const VanaClock& getVanaClock() const;
+
     // Name property access (implemented directly for convenience)
     std::string getPlayerName(DWORD procId) const;
 
@@ -126,6 +205,7 @@ public:
     void disableChatMonitoring();
     void pollChatMessages(); // Poll for new chat messages from all Elite API instances
     std::vector<ChatMessage> getRecentChatMessages(DWORD procId, int count = 50);
+    void setChatSubscriptions(std::vector<ChatSubscription> subscriptions); // Only matching lines are batched and sent
     void sendChatMessagesToServer(DWORD procId);
 
     // Debug/display
@@ -135,15 +215,40 @@ public:
     static PlayerProcessInfo* getProcessInfo(DWORD procId);
 };
 
+// The running Player, for properties that need names, IDs or the publisher (defined in TacticalPointsProperty.cpp)
+extern Player* g_playerInstance;
+
+// Escape a string for a JSON payload (defined in Player.cpp)
+std::string escapeJsonString(const std::string& input);
+
 // Abstract base class for player properties
 class PlayerProperty {
 protected:
     const wchar_t* dllName = L"FFXiMain.dll";
     mutable std::mutex propertyMutex;
 
+    // Change policy for numeric properties (nullptr = report every change)
+    std::shared_ptr<ChangePolicy> changePolicy;
+    std::map<DWORD, long long> lastReportedValues;
+
+    // Per-process change versions, bumped whenever the underlying value changes
+    std::map<DWORD, uint64_t> versions;
+
+    // Mark the value for a process as changed; call with propertyMutex held
+    void bumpVersion(DWORD procId);
+
+    // Evaluate the change policy for a numeric value; call from hasChanged() with propertyMutex held
+    bool passesChangePolicy(DWORD procId, long long currentValue) const;
+
+    // Record that a value was reported; call from acknowledgeChange() with propertyMutex held
+    void recordReportedValue(DWORD procId, long long value);
+
 public:
     virtual ~PlayerProperty() = default;
 
+    // Replace the change policy used by hasChanged()
+    void setChangePolicy(std::shared_ptr<ChangePolicy> policy);
+
     // Core property methods
     virtual void refresh(const PlayerProcessInfo& process) = 0;
     virtual const char* getPropertyName() const = 0;
@@ -153,4 +258,13 @@ public:
     virtual bool hasChanged(DWORD procId) const = 0;
     virtual void acknowledgeChange(DWORD procId) = 0;
     virtual void reportChange(DWORD procId) const = 0;
+
+    // Version of the value for a process; changes whenever the value does
+    uint64_t getVersion(DWORD procId) const;
+
+    // Called when a different character logs in on the process; drops identity-keyed state
+    virtual void onIdentityChanged(DWORD procId);
+
+    // Numeric view of the value, used by derived properties (0 if not numeric)
+    virtual long long getNumericValue(DWORD /*procId*/) const { return 0; }
 };
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Player/Player.h"
+#include "Player/EntityLayout.h"
+#include "helpers/memory.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/**
+ * Position of the character for map overlays. Each tick reads position,
+ * heading and speed in one call and compares them against a dead-
+ * reckoning prediction from the last emitted sample (straight line at
+ * the reported heading and speed). An update is emitted only when the
+ * prediction is off by more than POSITION_TOLERANCE, on zone change or
+ * teleport, or when a keyframe is due; a character walking in a straight
+ * line or standing still emits nothing. Consumers run the same predictor
+ * between updates.
+ *
+ * Wire format: coordinates quantized to 1/POSITION_SCALE yalm, sent as
+ * deltas from the previous update, with a periodic absolute keyframe so
+ * a feed that joins late or drops an update can resync.
+ */
+class PositionProperty : public PlayerProperty {
+public:
+    struct Position {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float heading = 0.0f;  // Radians, 0 = east
+        float speed = 0.0f;    // Yalms per second, 0 while standing still
+        uint16_t zone = 0;
+    };
+
+    PositionProperty();
+
+    // Implementation of base class abstract methods
+    virtual void refresh(const PlayerProcessInfo& process) override;
+    virtual const char* getPropertyName() const override;
+    virtual void displayValue(DWORD procId) const override;
+
+    // Change detection implementation (divergence from the prediction, not movement)
+    virtual bool hasChanged(DWORD procId) const override;
+    virtual void acknowledgeChange(DWORD procId) override;
+    virtual void reportChange(DWORD procId) const override;
+    virtual void onIdentityChanged(DWORD procId) override;
+
+    // Updates emitted so far for this character
+    virtual long long getNumericValue(DWORD procId) const override;
+
+    // Last sample read from the client
+    Position getPosition(DWORD procId) const;
+
+private:
+    static constexpr float POSITION_TOLERANCE = 1.0f;   // Yalms of prediction error before an update
+    static constexpr float TELEPORT_DISTANCE = 50.0f;   // A jump this large between ticks forces a keyframe
+    static constexpr float MOVE_EPSILON = 0.05f;        // Smaller per-tick motion counts as standing still
+    static const int POSITION_SCALE = 8;                // Quantization steps per yalm
+    static const int HEADING_STEPS = 256;
+    static const int KEYFRAME_INTERVAL_MS = 30000;
+
+    // Pointer to the local player's entity
+    DWORD localEntityOffset = 0x004A9A8C;
+    std::vector<unsigned int> localEntityOffsets = {0x00};
+
+    static const std::string API_ENDPOINT;
+
+    struct PositionState {
+        Position current;
+        bool loaded = false;
+
+        // Anchor of the prediction: the last emitted sample
+        Position anchor;
+        float velocityX = 0.0f;
+        float velocityY = 0.0f;
+        std::chrono::steady_clock::time_point anchorTime;
+        std::chrono::system_clock::time_point anchorWallTime;
+
+        // Wire state
+        int32_t sentX = 0, sentY = 0, sentZ = 0;  // Quantized position the consumer has
+        bool keyframe = true;
+        std::chrono::steady_clock::time_point lastKeyframe;
+        uint32_t sequence = 0;
+        bool pending = false;
+    };
+
+    std::map<DWORD, PositionState> states;
+
+    static int32_t quantize(float value);
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Compile-time property type identifier (address of a per-type tag)
+using PropertyTypeId = const void*;
+
+template <typename T>
+PropertyTypeId propertyTypeId()
+{
+    static const char tag = 0;
+    return &tag;
+}
+
+// FNV-1a hash of a property name, usable at compile time
+constexpr uint32_t hashPropertyName(const char* name, uint32_t hash = 2166136261u)
+{
+    return (*name == '\0') ? hash : hashPropertyName(name + 1, (hash ^ static_cast<unsigned char>(*name)) * 16777619u);
+}
+
+/**
+ * Typed, non-owning handle to a registered property.
+ * Resolve once via Player::findProperty<T>() and reuse; the pointed-to
+ * property lives as long as the Player that registered it.
+ */
+template <typename T>
+class PropertyHandle
+{
+private:
+    T* property;
+
+public:
+    PropertyHandle() : property(nullptr) {}
+    explicit PropertyHandle(T* property) : property(property) {}
+
+    bool valid() const { return property != nullptr; }
+    explicit operator bool() const { return valid(); }
+
+    T* get() const { return property; }
+    T* operator->() const { return property; }
+    T& operator*() const { return *property; }
+};
+
+/**
+ * Maps property type IDs and interned name hashes to slots in
+ * Player's property config list, replacing dynamic_cast/strcmp scans.
+ */
+class PropertyRegistry
+{
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    // Bind a type and name to a slot index
+    void bind(PropertyTypeId typeId, const char* name, size_t slot);
+
+    // Look up a slot by type; returns npos if not registered
+    size_t findByType(PropertyTypeId typeId) const;
+
+    // Look up a slot by name; returns npos if not registered
+    size_t findByName(const char* name) const;
+
+    // Look up a slot by precomputed name hash (skips collision check)
+    size_t findByHash(uint32_t nameHash) const;
+
+    void clear();
+
+private:
+    std::unordered_map<PropertyTypeId, size_t> slotsByType;
+    std::unordered_map<uint32_t, size_t> slotsByName;
+    std::vector<std::string> internedNames; // Indexed by slot, for collision checks
+};
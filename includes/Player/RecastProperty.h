@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Player/Player.h"
+#include "helpers/memory.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/**
+ * Ability and spell recast timers. Both recast arrays are read in one
+ * pass, converted to absolute ready-at times and then counted down
+ * locally; refresh() is cheap and only goes back to the client when a
+ * timer has run out, when requestResync() was called (chat/action event
+ * showing the character used something), or after a long safety
+ * interval. Reports carry ready-at timestamps rather than ticking
+ * numbers, so nothing needs publishing while timers simply count down.
+ */
+class RecastProperty : public PlayerProperty {
+public:
+    enum class RecastKind {
+        Ability,
+        Spell
+    };
+
+    struct RecastEntry {
+        uint16_t id;  // Ability recast ID or spell ID
+        std::chrono::system_clock::time_point readyAt;
+    };
+
+    RecastProperty();
+
+    // Implementation of base class abstract methods
+    virtual void refresh(const PlayerProcessInfo& process) override;
+    virtual const char* getPropertyName() const override;
+    virtual void displayValue(DWORD procId) const override;
+
+    // Change detection implementation
+    virtual bool hasChanged(DWORD procId) const override;
+    virtual void acknowledgeChange(DWORD procId) override;
+    virtual void reportChange(DWORD procId) const override;
+    virtual void onIdentityChanged(DWORD procId) override;
+
+    // Number of timers still running
+    virtual long long getNumericValue(DWORD procId) const override;
+
+    /**
+     * Force a read on the next refresh (e.g. the character just used an ability)
+     */
+    void requestResync(DWORD procId);
+
+    std::chrono::milliseconds getRemaining(DWORD procId, RecastKind kind, uint16_t id) const;
+    bool isReady(DWORD procId, RecastKind kind, uint16_t id) const;
+    std::vector<RecastEntry> getActive(DWORD procId, RecastKind kind) const;
+
+    // Resync reads actually issued, for diagnostics
+    uint64_t getReadCount() const;
+
+private:
+    static const size_t ABILITY_SLOTS = 32;
+    static const size_t SPELL_SLOTS = 1024;
+    static const uint32_t TICKS_PER_SECOND = 60;
+
+    // Read even without a trigger this often, in case a use was missed
+    static const int SAFETY_RESYNC_MS = 60000;
+
+    // Ready-at times that moved by less than this are not re-reported
+    static const int REPORT_TOLERANCE_MS = 1000;
+
+    DWORD abilityRecastOffset = 0x004A5F30;
+    std::vector<unsigned int> abilityRecastOffsets = {0x00};
+    DWORD spellRecastOffset = 0x004A6070;
+    std::vector<unsigned int> spellRecastOffsets = {0x00};
+
+    static const std::string API_ENDPOINT;
+
+#pragma pack(push, 1)
+    struct AbilityRecastTable {
+        uint8_t ids[ABILITY_SLOTS];
+        uint32_t timers[ABILITY_SLOTS];  // Ticks remaining
+    };
+#pragma pack(pop)
+
+    struct RecastState {
+        std::map<uint16_t, std::chrono::steady_clock::time_point> abilities;  // Recast ID -> ready at
+        std::map<uint16_t, std::chrono::steady_clock::time_point> spells;     // Spell ID -> ready at
+        std::chrono::steady_clock::time_point lastRead;
+        bool resyncRequested = true;
+        bool loaded = false;
+        bool dirty = false;             // Timers changed beyond tolerance since the last report
+    };
+
+    std::map<DWORD, RecastState> states;
+    uint64_t readCount = 0;
+
+    bool needsResync(const RecastState& state, std::chrono::steady_clock::time_point now) const;
+    static bool sameTimers(const std::map<uint16_t, std::chrono::steady_clock::time_point>& a,
+                           const std::map<uint16_t, std::chrono::steady_clock::time_point>& b);
+    static std::chrono::system_clock::time_point toWallClock(std::chrono::steady_clock::time_point readyAt);
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Player/Player.h"
+#include "helpers/memory.h"
+#include "helpers/bitset.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/**
+ * Buff/debuff tracker. Reads the player's status-effect table (IDs and
+ * timers) in one ReadProcessMemory per tick, folds it into a fixed-width
+ * bitset keyed by StatusEffect ID and diffs against the last reported set
+ * with a SIMD XOR. Remaining durations are counted down locally from the
+ * last read, so consumers can query them at any rate for free.
+ */
+class StatusEffectProperty : public PlayerProperty {
+public:
+    static const size_t MAX_STATUS_EFFECT_ID = 1024;  // StatusEffect IDs fit well below this
+    static const size_t MAX_BUFF_SLOTS = 32;          // Client buff table size
+    using StatusEffectSet = FixedBitset<MAX_STATUS_EFFECT_ID>;
+
+    struct StatusEffectChange {
+        std::vector<uint16_t> added;
+        std::vector<uint16_t> removed;
+    };
+
+    StatusEffectProperty();
+
+    // Implementation of base class abstract methods
+    virtual void refresh(const PlayerProcessInfo& process) override;
+    virtual const char* getPropertyName() const override;
+    virtual void displayValue(DWORD procId) const override;
+
+    // Change detection implementation
+    virtual bool hasChanged(DWORD procId) const override;
+    virtual void acknowledgeChange(DWORD procId) override;
+    virtual void reportChange(DWORD procId) const override;
+    virtual void onIdentityChanged(DWORD procId) override;
+
+    virtual long long getNumericValue(DWORD procId) const override; // Active effect count
+
+    // Property-specific methods
+    bool hasEffect(DWORD procId, uint16_t effectId) const;
+    StatusEffectSet getEffects(DWORD procId) const;
+
+    // Remaining duration counted down from the last read (zero if unknown or expired)
+    std::chrono::milliseconds getRemaining(DWORD procId, uint16_t effectId) const;
+
+    // Effects added/removed since the last acknowledged change
+    StatusEffectChange getPendingChange(DWORD procId) const;
+
+private:
+    // Buff table: MAX_BUFF_SLOTS x uint16 IDs followed by MAX_BUFF_SLOTS x uint32 timers
+    DWORD offsetToBaseAddress = 0x000012BC;
+    std::vector<unsigned int> offsets = {0x5E8};
+    static const uint16_t EMPTY_SLOT = 0x00FF;
+    static const unsigned int TIMER_TICKS_PER_SECOND = 60;
+
+    static const std::string API_ENDPOINT;
+
+#pragma pack(push, 1)
+    struct BuffTable {
+        uint16_t ids[MAX_BUFF_SLOTS];
+        uint32_t timers[MAX_BUFF_SLOTS];
+    };
+#pragma pack(pop)
+
+    struct EffectState {
+        StatusEffectSet current;
+        StatusEffectSet reported;
+        std::map<uint16_t, uint32_t> durationTicks; // Remaining ticks at readTime
+        std::chrono::steady_clock::time_point readTime;
+    };
+
+    std::map<DWORD, EffectState> effects;
+
+    static StatusEffectChange diff(const StatusEffectSet& before, const StatusEffectSet& after);
+};
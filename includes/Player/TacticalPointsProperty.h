@@ -2,12 +2,8 @@
 
 #include "Player/Player.h"
 #include "helpers/memory.h"
-#include "helpers/http.h"
 #include <map>
 
-// Forward declaration of global player instance
-extern Player* g_playerInstance;
-
 class TacticalPointsProperty : public PlayerProperty {
 private:
     DWORD offsetToBaseAddress = 0x000012BC;
@@ -16,16 +12,13 @@ private:
     // Storage for tactical points by process ID
     std::map<DWORD, int> tacticalPoints;
 
-    // Change tracking
+    // Change tracking (previousTP holds the last reported value, for logging)
     std::map<DWORD, int> previousTP;
-    std::map<DWORD, bool> changedFlags;
 
-    // HTTP client for sending TP updates
-    mutable HttpClient httpClient;
     static const std::string API_ENDPOINT;
 
-    // Helper method for sending TP data to API
-    void sendTPUpdate(const std::string& playerName, DWORD playerId, int tp) const;
+    // Helper method for queueing TP data to the change publisher
+    void sendTPUpdate(DWORD procId, const std::string& playerName, DWORD playerId, int tp) const;
 
     // Helper method to sanitize player name for JSON
     std::string sanitizePlayerName(const std::string& rawName) const;
@@ -44,6 +37,8 @@ public:
     virtual void acknowledgeChange(DWORD procId) override;
     virtual void reportChange(DWORD procId) const override;
 
+    virtual long long getNumericValue(DWORD procId) const override;
+
     // Property-specific methods
     int getTP(DWORD procId) const;
 };
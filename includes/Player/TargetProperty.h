@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Player/Player.h"
+#include "Player/EntityLayout.h"
+#include "helpers/memory.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Current target of the character. Each tick reads only the small
+ * target struct; the target's ID, name and claim are fetched through
+ * its entity pointer when the target index changes, and while a target
+ * exists one small read of the entity picks up distance and HP%.
+ * Names are cached by server ID, so re-targeting a known mob costs no
+ * name read.
+ */
+class TargetProperty : public PlayerProperty {
+public:
+    struct TargetInfo {
+        uint32_t index = 0;       // 0 = no target
+        uint32_t serverId = 0;
+        std::string name;
+        uint8_t hpp = 0;
+        float distance = 0.0f;    // Yalms
+        uint32_t claimId = 0;     // Server ID of the claiming player, 0 if unclaimed
+    };
+
+    TargetProperty();
+
+    // Implementation of base class abstract methods
+    virtual void refresh(const PlayerProcessInfo& process) override;
+    virtual const char* getPropertyName() const override;
+    virtual void displayValue(DWORD procId) const override;
+
+    // Change detection implementation
+    virtual bool hasChanged(DWORD procId) const override;
+    virtual void acknowledgeChange(DWORD procId) override;
+    virtual void reportChange(DWORD procId) const override;
+    virtual void onIdentityChanged(DWORD procId) override;
+
+    // Target server ID, 0 when nothing is targeted
+    virtual long long getNumericValue(DWORD procId) const override;
+
+    TargetInfo getTarget(DWORD procId) const;
+
+private:
+    // Distance changes below this are not reported
+    static constexpr float DISTANCE_TOLERANCE = 1.0f;
+
+    // Name cache is dropped wholesale past this size
+    static const size_t MAX_CACHED_NAMES = 4096;
+
+    DWORD targetOffset = 0x004A7C1C;
+    std::vector<unsigned int> targetOffsets = {0x00};
+
+    static const std::string API_ENDPOINT;
+
+#pragma pack(push, 1)
+    struct RawTarget {
+        uint32_t index;
+        uint32_t serverId;
+        uint32_t entityPointer;
+    };
+#pragma pack(pop)
+
+    struct TargetState {
+        TargetInfo current;
+        TargetInfo reported;       // Starts as "no target", so an idle character reports nothing
+        uint32_t entityPointer = 0;
+        bool pending = false;      // current differs from reported beyond tolerance
+    };
+
+    std::map<DWORD, TargetState> states;
+    std::unordered_map<uint32_t, std::string> nameCache;  // Server ID -> name, shared by all characters
+
+    bool readDetails(HANDLE hProcess, uint32_t entityPointer, TargetInfo& info);
+    void store(DWORD procId, const TargetInfo& info, uint32_t entityPointer);
+    static bool differs(const TargetInfo& a, const TargetInfo& b);
+};
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// SSE2 is baseline on x64 and opt-in on 32-bit (/arch:SSE2 or -msse2)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FFXI_BITSET_SSE2 1
+#endif
+
+/**
+ * Fixed-width bitset stored as 64-bit words, with SIMD bulk operations.
+ * Used for status effects and ownership tables where IDs are dense and
+ * bounded, so a diff or cross-character query is a handful of XOR/AND ops.
+ */
+template <size_t Bits>
+class FixedBitset {
+public:
+    static const size_t WordCount = (Bits + 63) / 64;
+
+    FixedBitset() { clear(); }
+
+    void clear() { std::memset(words, 0, sizeof(words)); }
+
+    void set(size_t bit)
+    {
+        if (bit < Bits)
+            words[bit >> 6] |= (uint64_t(1) << (bit & 63));
+    }
+
+    void reset(size_t bit)
+    {
+        if (bit < Bits)
+            words[bit >> 6] &= ~(uint64_t(1) << (bit & 63));
+    }
+
+    bool test(size_t bit) const
+    {
+        return bit < Bits && (words[bit >> 6] >> (bit & 63)) & 1;
+    }
+
+    bool any() const
+    {
+        for (size_t i = 0; i < WordCount; i++)
+        {
+            if (words[i])
+                return true;
+        }
+        return false;
+    }
+
+    size_t count() const
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < WordCount; i++)
+            total += popcount(words[i]);
+        return total;
+    }
+
+    bool operator==(const FixedBitset& other) const { return std::memcmp(words, other.words, sizeof(words)) == 0; }
+    bool operator!=(const FixedBitset& other) const { return !(*this == other); }
+
+    // out = a ^ b
+    static void xorOf(const FixedBitset& a, const FixedBitset& b, FixedBitset& out) { apply<OpXor>(a, b, out); }
+
+    // out = a & b
+    static void andOf(const FixedBitset& a, const FixedBitset& b, FixedBitset& out) { apply<OpAnd>(a, b, out); }
+
+    // out = a | b
+    static void orOf(const FixedBitset& a, const FixedBitset& b, FixedBitset& out) { apply<OpOr>(a, b, out); }
+
+    // out = a & ~b
+    static void andNotOf(const FixedBitset& a, const FixedBitset& b, FixedBitset& out) { apply<OpAndNot>(a, b, out); }
+
+    // Call fn(bitIndex) for every set bit, in ascending order
+    template <typename Fn>
+    void forEachSetBit(Fn fn) const
+    {
+        for (size_t i = 0; i < WordCount; i++)
+        {
+            uint64_t word = words[i];
+            while (word)
+            {
+                fn(i * 64 + countTrailingZeros(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+    const uint64_t* data() const { return words; }
+    uint64_t* data() { return words; }
+
+private:
+    alignas(16) uint64_t words[WordCount + (WordCount & 1)]; // Padded to whole 128-bit lanes
+
+    struct OpXor {
+        static uint64_t scalar(uint64_t a, uint64_t b) { return a ^ b; }
+#ifdef FFXI_BITSET_SSE2
+        static __m128i vector(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+#endif
+    };
+    struct OpAnd {
+        static uint64_t scalar(uint64_t a, uint64_t b) { return a & b; }
+#ifdef FFXI_BITSET_SSE2
+        static __m128i vector(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+#endif
+    };
+    struct OpOr {
+        static uint64_t scalar(uint64_t a, uint64_t b) { return a | b; }
+#ifdef FFXI_BITSET_SSE2
+        static __m128i vector(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+#endif
+    };
+    struct OpAndNot {
+        static uint64_t scalar(uint64_t a, uint64_t b) { return a & ~b; }
+#ifdef FFXI_BITSET_SSE2
+        static __m128i vector(__m128i a, __m128i b) { return _mm_andnot_si128(b, a); }
+#endif
+    };
+
+    template <typename Op>
+    static void apply(const FixedBitset& a, const FixedBitset& b, FixedBitset& out)
+    {
+#ifdef FFXI_BITSET_SSE2
+        const size_t lanes = (WordCount + 1) / 2; // Two words per 128-bit lane
+        for (size_t i = 0; i < lanes; i++)
+        {
+            __m128i va = _mm_load_si128(reinterpret_cast<const __m128i*>(a.words) + i);
+            __m128i vb = _mm_load_si128(reinterpret_cast<const __m128i*>(b.words) + i);
+            _mm_store_si128(reinterpret_cast<__m128i*>(out.words) + i, Op::vector(va, vb));
+        }
+#else
+        for (size_t i = 0; i < WordCount; i++)
+            out.words[i] = Op::scalar(a.words[i], b.words[i]);
+#endif
+    }
+
+    static size_t countTrailingZeros(uint64_t word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctzll(word));
+#else
+        size_t n = 0;
+        while (!(word & 1))
+        {
+            word >>= 1;
+            n++;
+        }
+        return n;
+#endif
+    }
+
+    static size_t popcount(uint64_t word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(word));
+#else
+        size_t n = 0;
+        while (word)
+        {
+            word &= word - 1;
+            n++;
+        }
+        return n;
+#endif
+    }
+};
@@ -2,13 +2,28 @@
 #define CHATLOGMONITOR_H
 
 #include <string>
+#include <string_view>
 #include <functional>
 #include <thread>
 #include <atomic>
-#include <map>
-#include <fstream>
+#include <memory>
+#include <chrono>
+#include <filesystem>
+#include <set>
 #include "Player/ChatMessage.h"
 
+/**
+ * Tails the client's chat log. The log file stays open for the whole
+ * session and is read in large blocks from where the last read stopped;
+ * the thread sleeps on change notifications for the log directory
+ * (ReadDirectoryChangesW on Windows, inotify elsewhere) and switches to a
+ * new session log as soon as the client creates one. Only logs that were
+ * not in the directory before are switched to, so boxed clients writing
+ * their own logs next to ours are ignored. Size notifications can be
+ * late, so the file size is also checked every 100 ms; the directory is
+ * only listed again after a notification overflow, or once a second when
+ * it can't be watched at all.
+ */
 class ChatLogMonitor {
 public:
     using ChatCallback = std::function<void(const ChatMessage&)>;
@@ -27,6 +42,7 @@ public:
 
 private:
     std::string playerName;
+    std::string logDirectory;
     std::string logFilePath;
     ChatCallback callback;
 
@@ -34,19 +50,50 @@ private:
     std::atomic<bool> shouldStop;
     std::atomic<bool> isActive;
 
-    std::streampos lastPosition;
+    // Open log file and directory watch (platform handles, see chatlogmonitor.cpp)
+    struct Tail;
+    std::unique_ptr<Tail> tail;
 
-    // Find the log file for this player
+    // Every log path seen in the directory (see NoteCreatedLog)
+    std::set<std::string> knownLogs;
+    std::chrono::steady_clock::time_point lastRescan;
+
+    // Bytes read but not yet split into lines; a partial last line waits here
+    std::string pending;
+
+    // Control-code-free copy of the line being parsed
+    std::string cleanLine;
+
+    // Find the log directory and the newest log file for this player
     bool FindLogFile(const std::string& playerName);
 
+    // Open a log file, replacing the current one only if it succeeds
+    bool OpenLogFile(const std::string& path, bool fromEnd);
+    void CloseLogFile();
+
+    // Directory change notifications and the stop signal that wakes the thread
+    bool StartWatching();
+    void StopWatching();
+    void SignalStop();
+
+    // Read everything written since the last call and dispatch the complete lines
+    void ReadNewLines();
+
+    // Block until the directory changes, stop is requested, or the poll interval
+    // passes; newLogPath is set when a log file that wasn't seen before appeared.
+    // False when stopping
+    bool WaitForChange(std::string& newLogPath);
+
+    // Record a created file; newLogPath is set if it is a log not seen before
+    void NoteCreatedLog(const std::filesystem::path& path, std::string& newLogPath);
+
     // Monitor thread function
     void MonitorThreadFunc();
 
-    // Parse a chat log line
-    ChatMessage ParseLogLine(const std::string& line);
+    void DispatchLine(std::string_view line);
 
-    // Extract chat type from log line prefix
-    ChatMessageType ExtractChatType(const std::string& line);
+    // Parse a chat log line (see ChatParser)
+    ChatMessage ParseLogLine(std::string_view line);
 };
 
 #endif // CHATLOGMONITOR_H
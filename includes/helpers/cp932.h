@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * Shift-JIS (Windows code page 932) to UTF-8, without the Win32 code
+ * page API. Every byte and byte pair maps straight to a code point
+ * through two lookup tables (cp932table.cpp), so conversion is one pass
+ * with no wide-string round trip, and runs of ASCII are copied 16 or 32
+ * bytes at a time. Bytes with no mapping become U+FFFD.
+ *
+ * Decoder keeps a lead byte that ends one chunk and joins it with the
+ * first byte of the next, for text that arrives in blocks (log files).
+ */
+namespace CP932 {
+
+const int LEAD_COUNT = 60;    // 0x81-0x9F, 0xE0-0xFC
+const int TRAIL_COUNT = 189;  // 0x40-0xFC (0x7F is never mapped)
+const uint32_t REPLACEMENT = 0xFFFD;
+
+extern const uint16_t SINGLE_BYTE[256];
+extern const uint16_t DOUBLE_BYTE[LEAD_COUNT][TRAIL_COUNT];
+
+inline bool isLeadByte(uint8_t byte)
+{
+	return (byte >= 0x81 && byte <= 0x9F) || (byte >= 0xE0 && byte <= 0xFC);
+}
+
+// Code point of a single byte; 0 if it has none (lead bytes included)
+inline uint32_t toCodePoint(uint8_t byte)
+{
+	return SINGLE_BYTE[byte];
+}
+
+// Code point of a lead/trail pair; 0 if the pair has none
+inline uint32_t toCodePoint(uint8_t lead, uint8_t trail)
+{
+	if (trail < 0x40 || trail > 0xFC)
+		return 0;
+	int row = (lead <= 0x9F) ? lead - 0x81 : lead - 0xE0 + 0x1F;
+	return DOUBLE_BYTE[row][trail - 0x40];
+}
+
+// Write a BMP code point as UTF-8; returns the bytes written (1-3)
+inline size_t encodeUtf8(uint32_t codePoint, char *dst)
+{
+	if (codePoint < 0x80)
+	{
+		dst[0] = static_cast<char>(codePoint);
+		return 1;
+	}
+	if (codePoint < 0x800)
+	{
+		dst[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+		dst[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+		return 2;
+	}
+	dst[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+	dst[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+	dst[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+	return 3;
+}
+
+class Decoder {
+public:
+	// Append the UTF-8 form of input to out. A lead byte at the very end
+	// is held back until the next call (or finish()).
+	void decode(std::string_view input, std::string &out);
+
+	// End of stream: a held lead byte becomes U+FFFD
+	void finish(std::string &out);
+
+	void reset() { pendingLead = 0; }
+
+private:
+	uint8_t pendingLead = 0;
+};
+
+// Whole-buffer conversion; a truncated final lead byte becomes U+FFFD
+std::string toUtf8(std::string_view input);
+
+} // namespace CP932
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class ResourceTables;
+
+/**
+ * The one decoder for text that comes out of the client (chat lines,
+ * names, anything headed for JSON). Every byte value maps to an action
+ * in a 256-entry table: keep it, drop it, or escape it, plus how many
+ * parameter bytes that follow belong to it (colour codes carry one;
+ * Shift-JIS lead bytes carry their trail byte, so a trail byte that
+ * happens to look like ASCII is never split off). Runs of plain ASCII
+ * are copied 16 bytes (SSE2) or 32 bytes (AVX2) at a time. Json output
+ * is UTF-8: Shift-JIS text is transcoded in the same pass (see cp932.h).
+ *
+ * Control codes, the same in every profile:
+ *   0x00-0x1D  dropped
+ *   0x1E xx    colour change, dropped with its parameter
+ *   0x1F xx    chat colour, dropped with its parameter
+ *   0x7F xx    client marker, dropped with its parameter
+ *   0xFD t l c i 0xFD
+ *              auto-translate token (type, language, category, index).
+ *              Chat and Json put the phrase from the phrase table in its
+ *              place, in braces as the client shows it ("{Do you need a
+ *              party?}"); Printable, and any token the table does not
+ *              know, drop it whole. Resolved inside the same pass.
+ */
+namespace FFXIText {
+
+enum class Profile {
+	Printable,  // Printable ASCII only: names, senders, parser input
+	Chat,       // Control codes stripped, Shift-JIS text kept for transcoding
+	Json        // Control codes stripped, Shift-JIS as UTF-8, '"' and '\' escaped
+};
+
+enum class Action : uint8_t {
+	Keep,
+	Drop,
+	Escape,     // Emit a backslash, then the byte
+	Transcode,  // Emit the byte (with its trail byte) as UTF-8
+	Phrase      // Auto-translate token
+};
+
+struct ByteRule {
+	Action action;
+	uint8_t params;  // Following bytes that share the action
+};
+
+// Table that auto-translate tokens resolve against (nullptr to stop resolving).
+// Set once the resource file is mapped; the tables must outlive any decode call.
+void setPhraseTable(const ResourceTables *tables);
+
+// Rule table of a profile, for callers that scan text themselves
+const ByteRule *rulesFor(Profile profile);
+
+// Append the decoded form of input to out
+void decode(std::string_view input, Profile profile, std::string &out);
+
+std::string decode(std::string_view input, Profile profile);
+
+} // namespace FFXIText
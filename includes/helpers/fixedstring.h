@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+/**
+ * Short string stored inline: N - 1 characters plus a length byte, so
+ * sizeof(FixedString<N>) == N and copying one never allocates. Used for
+ * character names (at most 15 characters in FFXI); longer input is cut
+ * to capacity().
+ */
+template <size_t N>
+class FixedString {
+    static_assert(N >= 2 && N <= 256, "length must fit in one byte");
+
+public:
+    FixedString() : chars{}, length(0) {}
+
+    explicit FixedString(std::string_view text) : chars{}, length(0) { assign(text); }
+
+    void assign(std::string_view text)
+    {
+        length = static_cast<uint8_t>(text.size() < capacity() ? text.size() : capacity());
+        std::memcpy(chars, text.data(), length);
+        std::memset(chars + length, 0, capacity() - length);
+    }
+
+    static constexpr size_t capacity() { return N - 1; }
+
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    const char *data() const { return chars; }
+    std::string_view view() const { return std::string_view(chars, length); }
+
+    // Unused bytes are zeroed, so equality is one compare of the whole buffer
+    bool operator==(const FixedString &other) const { return std::memcmp(this, &other, N) == 0; }
+    bool operator!=(const FixedString &other) const { return !(*this == other); }
+
+    struct Hash {
+        size_t operator()(const FixedString &text) const
+        {
+            uint64_t h = 0xcbf29ce484222325ULL;
+            for (size_t i = 0; i < text.length; i++)
+            {
+                h ^= static_cast<unsigned char>(text.chars[i]);
+                h *= 0x100000001b3ULL;
+            }
+            return static_cast<size_t>(h);
+        }
+    };
+
+private:
+    char chars[N - 1];
+    uint8_t length;
+};
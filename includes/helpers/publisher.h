@@ -0,0 +1,147 @@
+#pragma once
+
+#include <Windows.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+
+/**
+ * Asynchronous change publisher with latest-value-wins coalescing.
+ * Each (process, property) pair owns a single pending slot; publishing
+ * again before the slot is drained replaces the payload. A background
+ * thread drains slots in FIFO order and POSTs the latest value. A slot
+ * whose POST fails or that goes stale in the queue is kept and sent again
+ * a second later, unless a newer value replaces it first.
+ *
+ * Diffs and deltas can't be coalesced, so publishOrdered() gives each
+ * payload its own slot. When one of them is dropped or its POST fails
+ * the stream is marked lost, and the owner resends a full snapshot once
+ * takeLost() reports it.
+ */
+class ChangePublisher {
+public:
+    /**
+     * Exported publisher counters
+     */
+    struct Stats {
+        uint64_t enqueued;   // publish() calls
+        uint64_t coalesced;  // Payloads replaced before they were sent
+        uint64_t dropped;    // Ordered payloads discarded for exceeding max staleness (or pending on stop)
+        uint64_t sent;       // Successful POSTs
+        uint64_t failed;     // Failed POSTs
+        uint64_t retried;    // Failed or stale coalesced payloads queued again
+    };
+
+    ChangePublisher();
+    ~ChangePublisher();
+
+    /**
+     * Start the publisher thread (no-op if already running)
+     */
+    void start();
+
+    /**
+     * Stop the publisher thread; pending payloads are counted as dropped
+     */
+    void stop();
+
+    bool isRunning() const;
+
+    /**
+     * Payloads older than this when dequeued are dropped instead of sent
+     * @param maxStaleness Maximum age of a payload; zero disables the check
+     */
+    void setMaxStaleness(std::chrono::milliseconds maxStaleness);
+
+    /**
+     * Set the HTTP timeout used by the publisher thread
+     * @param seconds Timeout in seconds
+     */
+    void setRequestTimeout(long seconds);
+
+    /**
+     * Enqueue the latest payload for a (process, property) slot
+     * @param procId Process the change belongs to
+     * @param key Property key (usually getPropertyName())
+     * @param url Endpoint to POST to
+     * @param jsonPayload JSON body
+     */
+    void publish(DWORD procId, const std::string& key, const std::string& url, const std::string& jsonPayload);
+
+    /**
+     * Enqueue a payload that must not be replaced by a later one (a diff
+     * or delta); payloads of a stream are sent in publish order
+     * @param procId Process the change belongs to
+     * @param stream Stream key (usually getPropertyName())
+     * @param url Endpoint to POST to
+     * @param jsonPayload JSON body
+     */
+    void publishOrdered(DWORD procId, const std::string& stream, const std::string& url, const std::string& jsonPayload);
+
+    /**
+     * Whether an ordered payload of the stream was dropped or failed since
+     * the last takeLost()
+     */
+    bool isLost(DWORD procId, const std::string& stream) const;
+
+    /**
+     * Like isLost(), and clears the mark; call when building the payload
+     * that resynchronizes the receiver
+     */
+    bool takeLost(DWORD procId, const std::string& stream);
+
+    /**
+     * Snapshot of the publisher counters
+     */
+    Stats getStats() const;
+
+    /**
+     * Number of slots currently waiting to be sent
+     */
+    size_t pendingCount() const;
+
+private:
+    using SlotKey = std::pair<DWORD, std::string>;
+
+    struct Slot {
+        std::string url;
+        std::string payload;
+        std::chrono::steady_clock::time_point updatedAt;
+        bool pending = false;
+        std::string stream;  // Set for ordered payloads
+    };
+
+    std::map<SlotKey, Slot> slots;
+    std::map<SlotKey, Slot> parkedSlots;  // Failed or stale publish() values awaiting a retry
+    std::chrono::steady_clock::time_point retryAt;
+    std::set<SlotKey> lostStreams;
+    uint64_t orderedSequence;
+    std::deque<SlotKey> readyQueue;  // Keys of pending slots, in first-enqueued order
+    mutable std::mutex slotMutex;
+    std::condition_variable slotCondition;
+
+    std::thread publisherThread;
+    std::atomic<bool> running;
+    std::chrono::milliseconds maxStaleness;
+    long requestTimeoutSeconds;
+
+    std::atomic<uint64_t> enqueuedCount;
+    std::atomic<uint64_t> coalescedCount;
+    std::atomic<uint64_t> droppedCount;
+    std::atomic<uint64_t> sentCount;
+    std::atomic<uint64_t> failedCount;
+    std::atomic<uint64_t> retriedCount;
+
+    void enqueue(const SlotKey& slotKey, const std::string& url, const std::string& jsonPayload, const std::string& stream);
+    void park(const SlotKey& slotKey, Slot&& slot);  // Caller holds slotMutex
+    void requeueParked();                           // Caller holds slotMutex
+    void publisherThreadFunc();
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * On-disk layout of the static game-data file produced by tools/resgen
+ * and mapped by ResourceTables. Everything is little-endian, 4-byte
+ * aligned and addressed by offsets from the start of the file, so the
+ * service can use the mapped view directly without parsing.
+ *
+ * Each table holds its records plus two minimal perfect hash indexes
+ * (hash-and-displace): one by ID and one by lowercase name. A lookup is
+ * bucket = hash(key, 0) % bucketCount, then
+ * slot = hash(key, displacement[bucket]) % recordCount, then one key
+ * compare against records[slots[slot]] to reject unknown keys.
+ */
+namespace ResourceFormat {
+
+static const char MAGIC[8] = {'F', 'F', 'X', 'I', 'R', 'E', 'S', '1'};
+static const uint32_t VERSION = 2;
+
+enum class TableKind : uint32_t {
+    Items = 0,
+    Spells,
+    Abilities,
+    Zones,
+    AutoTranslate,  // ID is (category << 8) | index, name is the phrase text
+    Count
+};
+
+static const size_t TABLE_COUNT = static_cast<size_t>(TableKind::Count);
+
+struct PerfectHashIndex {
+    uint32_t bucketCount;
+    uint32_t displacementsOffset;  // uint32_t[bucketCount]
+    uint32_t slotsOffset;          // uint32_t[recordCount], record index per slot
+};
+
+struct TableHeader {
+    uint32_t recordCount;
+    uint32_t recordsOffset;        // Record[recordCount], sorted by ID
+    PerfectHashIndex byId;
+    PerfectHashIndex byName;
+};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t fileSize;
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+    TableHeader tables[TABLE_COUNT];
+};
+
+/**
+ * One row. attributes[] are table specific:
+ *   Items:     flags, stack size
+ *   Spells:    MP cost, recast ID
+ *   Abilities: TP cost, recast ID
+ *   Zones:     region, unused
+ *   AutoTranslate: unused
+ */
+struct Record {
+    uint32_t id;
+    uint32_t nameOffset;       // Into the string pool, as written
+    uint32_t nameLength;
+    uint32_t lowerNameOffset;  // Into the string pool, ASCII-lowercased
+    uint32_t attributes[2];
+};
+
+// Seeded 64-bit hash shared by the generator and the loader
+inline uint64_t hash(const void* data, size_t length, uint32_t seed)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t h = 0xcbf29ce484222325ULL ^ (static_cast<uint64_t>(seed) * 0x9E3779B97F4A7C15ULL);
+    for (size_t i = 0; i < length; i++)
+    {
+        h ^= bytes[i];
+        h *= 0x100000001b3ULL;
+    }
+
+    // Finalizer so nearby keys land in unrelated buckets
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+inline char toLowerAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+} // namespace ResourceFormat
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "helpers/resourceformat.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * Read-only view over the memory-mapped game-data file (items, spells,
+ * abilities, zones, auto-translate phrases). The file is mapped once at startup and used in
+ * place; lookups are a perfect-hash probe plus one compare and never
+ * touch the game process or the DLL.
+ */
+class ResourceTables {
+public:
+    using Kind = ResourceFormat::TableKind;
+    using Record = ResourceFormat::Record;
+
+    ResourceTables();
+    ~ResourceTables();
+
+    ResourceTables(const ResourceTables&) = delete;
+    ResourceTables& operator=(const ResourceTables&) = delete;
+
+    /**
+     * Map a resource file; replaces any previously mapped file
+     * @param path Path to the file written by tools/resgen
+     * @return true if the file was mapped and its header validated
+     */
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    /**
+     * Find a record by ID (nullptr if absent)
+     */
+    const Record* findById(Kind kind, uint32_t id) const;
+
+    /**
+     * Find a record by name, case-insensitive (nullptr if absent)
+     */
+    const Record* findByName(Kind kind, std::string_view name) const;
+
+    /**
+     * Name of a record as stored in the file
+     */
+    std::string_view getName(const Record* record) const;
+
+    /**
+     * Convenience: name for an ID, or an empty view if unknown
+     */
+    std::string_view nameOf(Kind kind, uint32_t id) const;
+
+    size_t getRecordCount(Kind kind) const;
+
+private:
+    const uint8_t* base;
+    size_t size;
+    const ResourceFormat::FileHeader* header;
+
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+
+    bool validate() const;
+    const ResourceFormat::TableHeader* table(Kind kind) const;
+    const uint32_t* words(uint32_t offset) const;
+    const Record* lookup(const ResourceFormat::TableHeader& table, const ResourceFormat::PerfectHashIndex& index,
+                         const void* key, size_t keyLength) const;
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Uniform 2D grid over the X/Y plane for neighbour queries. Items are
+ * identified by a small integer index (e.g. an entity slot); the grid
+ * remembers each item's cell so a position update only touches the grid
+ * when the item actually crosses a cell boundary.
+ */
+class SpatialGrid {
+public:
+    static constexpr float MAX_COORDINATE = 100000.0f;
+
+    /**
+     * @param cellSize Edge length of a cell in world units (yalms)
+     * @param capacity Largest item index + 1
+     */
+    SpatialGrid(float cellSize, size_t capacity);
+
+    /**
+     * Insert or move an item; cheap when it stays in the same cell.
+     * A non-finite position or one beyond MAX_COORDINATE (garbage read
+     * from memory) removes the item instead and returns false.
+     */
+    bool update(uint32_t index, float x, float y);
+
+    /**
+     * Remove an item (no-op if not present)
+     */
+    void remove(uint32_t index);
+
+    void clear();
+
+    bool contains(uint32_t index) const;
+    size_t size() const;
+
+    /**
+     * Indices of all items within radius of (x, y)
+     */
+    std::vector<uint32_t> queryRadius(float x, float y, float radius) const;
+
+    /**
+     * Up to k nearest items to (x, y), closest first, optionally skipping one index
+     */
+    std::vector<uint32_t> queryNearest(float x, float y, size_t k, uint32_t exclude = UINT32_MAX) const;
+
+private:
+    using CellKey = uint64_t;
+
+    struct ItemState {
+        float x = 0.0f;
+        float y = 0.0f;
+        CellKey cell = 0;
+        uint32_t slotInCell = 0;  // Position inside the cell's vector, for O(1) removal
+        bool present = false;
+    };
+
+    float cellSize;
+    float inverseCellSize;
+    std::vector<ItemState> items;
+    std::unordered_map<CellKey, std::vector<uint32_t>> cells;
+    size_t itemCount;
+
+    int32_t cellCoord(float value) const;  // Clamped, so ring arithmetic can't overflow
+    static CellKey makeKey(int32_t cx, int32_t cy);
+    void removeFromCell(uint32_t index);
+
+    // Visit every item in the square ring of cells at Chebyshev distance `ring` from (cx, cy)
+    template <typename Fn>
+    void forEachInRing(int32_t cx, int32_t cy, int32_t ring, Fn fn) const;
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Vana'diel clock computed from Earth time. Game time runs 25x Earth
+ * time from a fixed epoch, so time of day, weekday and moon phase are a
+ * pure function of the system clock and need no reads from the client.
+ * verify() compares against one raw reading from a client after attach
+ * and absorbs any constant offset (server clock skew, epoch drift) of up
+ * to a Vana'diel day; a reading further off is ignored.
+ */
+class VanaClock {
+public:
+    // Matches EliteMMO.API.Weekday
+    enum class Weekday : uint8_t {
+        Firesday = 0,
+        Earthsday,
+        Watersday,
+        Windsday,
+        Iceday,
+        Lightningday,
+        Lightsday,
+        Darksday
+    };
+
+    // Matches EliteMMO.API.MoonPhase
+    enum class MoonPhase : uint8_t {
+        New = 0,
+        WaxingCrescent,
+        WaxingCrescent2,
+        FirstQuarter,
+        WaxingGibbous,
+        WaxingGibbous2,
+        Full,
+        WaningGibbous,
+        WaningGibbous2,
+        LastQuarter,
+        WaningCrescent,
+        WaningCrescent2
+    };
+
+    struct VanaTime {
+        uint64_t rawSeconds;   // Vana'diel seconds since the Vana'diel epoch
+        uint32_t year;
+        uint32_t month;        // 1-12
+        uint32_t day;          // 1-30
+        uint32_t hour;
+        uint32_t minute;
+        uint32_t second;
+        Weekday weekday;
+        MoonPhase moonPhase;
+        uint32_t moonPercent;  // 0 (new) - 100 (full)
+    };
+
+    // A Vana'diel minute every 2.4 Earth seconds
+    static const uint32_t TIME_SCALE = 25;
+    static const uint32_t SECONDS_PER_DAY = 86400;
+    static const uint32_t DAYS_PER_MONTH = 30;
+    static const uint32_t DAYS_PER_YEAR = 360;
+    static const uint32_t MOON_CYCLE_DAYS = 84;
+
+    // Earth-seconds-per-Vana'diel-hour, for callers scheduling on hour boundaries
+    static constexpr double EARTH_SECONDS_PER_VANA_HOUR = 3600.0 / TIME_SCALE;
+
+    VanaClock();
+
+    VanaTime now() const;
+    VanaTime at(std::chrono::system_clock::time_point earthTime) const;
+
+    /**
+     * Uncorrected Vana'diel seconds for an Earth time
+     */
+    static uint64_t toRawSeconds(std::chrono::system_clock::time_point earthTime);
+
+    /**
+     * Vana'diel seconds for the client's own 32-bit clock (Earth seconds
+     * since the epoch below)
+     */
+    static uint64_t fromClientSeconds(uint32_t clientSeconds);
+
+    /**
+     * Break raw Vana'diel seconds into calendar fields
+     */
+    static VanaTime fromRawSeconds(uint64_t rawSeconds);
+
+    /**
+     * Check the computed clock against a raw reading taken at observedAt and
+     * adopt the difference as a correction. A difference beyond
+     * MAX_CORRECTION_SECONDS is treated as a bad read: the clock stays
+     * as it is and unverified, so a later reading is checked again.
+     * @return true if the computed clock was already within tolerance
+     */
+    bool verify(uint64_t observedRawSeconds, std::chrono::system_clock::time_point observedAt);
+
+    bool isVerified() const;
+    int64_t getCorrectionSeconds() const;
+
+    static const char* weekdayName(Weekday weekday);
+    static const char* moonPhaseName(MoonPhase phase);
+
+private:
+    // 2002-01-01 00:00:00 JST, which the game treats as 0898-02-01 00:00
+    static const int64_t EARTH_EPOCH_UNIX = 1009810800;
+    static const uint64_t VANA_EPOCH_SECONDS = (898ULL * DAYS_PER_YEAR + 30ULL) * SECONDS_PER_DAY;
+
+    // Shifts day numbers so cycle day 42 is the full moon that began 2004-01-25 02:31:12 UTC
+    static const uint32_t MOON_CYCLE_OFFSET = 2;
+
+    // Readings this close (in Vana'diel seconds) are treated as agreeing
+    static const int64_t VERIFY_TOLERANCE_SECONDS = 60 * TIME_SCALE;
+
+    // Largest correction verify() will adopt: one Vana'diel day
+    static const int64_t MAX_CORRECTION_SECONDS = SECONDS_PER_DAY;
+
+    std::atomic<int64_t> correctionSeconds;
+    std::atomic<bool> verified;
+};
@@ -0,0 +1,93 @@
+#include "Player/ChangePolicy.h"
+#include <algorithm>
+#include <utility>
+
+bool ExactChangePolicy::shouldReport(DWORD, long long lastReported, long long current, Clock::time_point)
+{
+	return lastReported != current;
+}
+
+DeltaChangePolicy::DeltaChangePolicy(long long minDelta) : minDelta(minDelta)
+{
+}
+
+bool DeltaChangePolicy::shouldReport(DWORD, long long lastReported, long long current, Clock::time_point)
+{
+	long long delta = (current > lastReported) ? current - lastReported : lastReported - current;
+	return delta >= minDelta;
+}
+
+BandChangePolicy::BandChangePolicy(std::vector<long long> thresholds, long long hysteresis)
+	: thresholds(std::move(thresholds)), hysteresis(hysteresis)
+{
+	std::sort(this->thresholds.begin(), this->thresholds.end());
+}
+
+size_t BandChangePolicy::bandFor(long long value) const
+{
+	// Band index = number of thresholds at or below the value
+	return std::upper_bound(thresholds.begin(), thresholds.end(), value) - thresholds.begin();
+}
+
+size_t BandChangePolicy::nextBand(size_t currentBand, long long value) const
+{
+	size_t rawBand = bandFor(value);
+	if (rawBand >= currentBand)
+	{
+		// Rising (or staying) takes effect as soon as a threshold is reached
+		return rawBand;
+	}
+
+	// Falling only counts once the value is hysteresis below the threshold
+	return std::max(rawBand, bandFor(value + hysteresis));
+}
+
+size_t BandChangePolicy::reportedBand(DWORD procId, long long lastReported) const
+{
+	auto it = reportedBands.find(procId);
+	return (it != reportedBands.end()) ? it->second : bandFor(lastReported);
+}
+
+bool BandChangePolicy::shouldReport(DWORD procId, long long lastReported, long long current, Clock::time_point)
+{
+	size_t band = reportedBand(procId, lastReported);
+	return nextBand(band, current) != band;
+}
+
+void BandChangePolicy::onReported(DWORD procId, long long value, Clock::time_point)
+{
+	auto it = reportedBands.find(procId);
+	reportedBands[procId] = (it != reportedBands.end()) ? nextBand(it->second, value) : bandFor(value);
+}
+
+void BandChangePolicy::reset(DWORD procId)
+{
+	reportedBands.erase(procId);
+}
+
+RateLimitedChangePolicy::RateLimitedChangePolicy(std::shared_ptr<ChangePolicy> inner, std::chrono::milliseconds minInterval)
+	: inner(inner ? std::move(inner) : std::make_shared<ExactChangePolicy>()), minInterval(minInterval)
+{
+}
+
+bool RateLimitedChangePolicy::shouldReport(DWORD procId, long long lastReported, long long current, Clock::time_point now)
+{
+	auto it = lastReportTimes.find(procId);
+	if (it != lastReportTimes.end() && now - it->second < minInterval)
+	{
+		return false;
+	}
+	return inner->shouldReport(procId, lastReported, current, now);
+}
+
+void RateLimitedChangePolicy::onReported(DWORD procId, long long value, Clock::time_point now)
+{
+	lastReportTimes[procId] = now;
+	inner->onReported(procId, value, now);
+}
+
+void RateLimitedChangePolicy::reset(DWORD procId)
+{
+	lastReportTimes.erase(procId);
+	inner->reset(procId);
+}
@@ -0,0 +1,168 @@
+#include "Player/ChatBatch.h"
+#include "helpers/ffxitext.h"
+
+static_assert(sizeof(ChatBatch::SenderName) == 16, "sender names are stored inline");
+
+namespace {
+
+// Lines are capped at 64 KB so their lengths fit in an entry
+const size_t MAX_FIELD = 0xFFFF;
+
+inline std::string_view clampField(std::string_view text)
+{
+    return text.size() > MAX_FIELD ? text.substr(0, MAX_FIELD) : text;
+}
+
+} // namespace
+
+uint16_t ChatBatch::intern(const SenderName& name)
+{
+    auto it = senderIds.find(name);
+    if (it != senderIds.end())
+    {
+        return it->second;
+    }
+
+    uint16_t id = static_cast<uint16_t>(senders.size());
+    senders.push_back(name);
+    senderIds.emplace(name, id);
+    return id;
+}
+
+void ChatBatch::append(const ChatMessageView& view)
+{
+    static_assert(sizeof(Entry) <= 24, "entries are meant to stay compact");
+
+    // Only names still referenced are kept when the table is rebuilt
+    if (senders.size() >= MAX_SENDERS)
+    {
+        compact();
+    }
+
+    std::string_view raw = clampField(view.rawContent);
+    std::string_view message = clampField(view.message);
+
+    Entry entry;
+    entry.timestampNs = view.timestampNs;
+    entry.type = view.type;
+    entry.flags = view.senderPrefix.empty() ? 0 : SENT_TELL;
+    entry.rawOffset = static_cast<uint32_t>(arena.size());
+    entry.rawLength = static_cast<uint16_t>(raw.size());
+    entry.messageLength = static_cast<uint16_t>(message.size());
+    arena.append(raw.data(), raw.size());
+
+    // The parser slices the message out of the raw line; anything else
+    // (e.g. a source that rebuilt it) is stored right after the raw text
+    const char* rawBegin = raw.data();
+    if (message.data() >= rawBegin && message.data() + message.size() <= rawBegin + raw.size())
+    {
+        entry.messageStart = static_cast<uint16_t>(message.data() - rawBegin);
+    }
+    else
+    {
+        size_t room = MAX_FIELD - raw.size();
+        if (message.size() > room)
+        {
+            message = message.substr(0, room);
+            entry.messageLength = static_cast<uint16_t>(room);
+        }
+        entry.messageStart = entry.rawLength;
+        arena.append(message.data(), message.size());
+    }
+
+    // Sender is cleaned on the way in
+    senderScratch.clear();
+    FFXIText::decode(view.sender, FFXIText::Profile::Printable, senderScratch);
+    entry.sender = intern(SenderName(senderScratch));
+
+    entries.push_back(entry);
+}
+
+void ChatBatch::trimTo(size_t maxMessages)
+{
+    if (entries.size() <= maxMessages)
+    {
+        return;
+    }
+
+    entries.erase(entries.begin(), entries.end() - maxMessages);
+
+    // Reclaim the arena once most of it belongs to dropped messages
+    if (!entries.empty() && entries.front().rawOffset > arena.size() / 2)
+    {
+        compact();
+    }
+}
+
+void ChatBatch::compact()
+{
+    std::string live;
+    if (!entries.empty())
+    {
+        live.reserve(arena.size() - entries.front().rawOffset);
+    }
+    for (Entry& entry : entries)
+    {
+        uint32_t offset = static_cast<uint32_t>(live.size());
+        live.append(arena, entry.rawOffset, entry.end() - entry.rawOffset);
+        entry.rawOffset = offset;
+    }
+    arena.swap(live);
+
+    // The sender table is only rebuilt once it must hold names nobody uses
+    if (senders.size() <= entries.size() && senders.size() < MAX_SENDERS)
+    {
+        return;
+    }
+
+    std::vector<SenderName> liveSenders;
+    senderIds.clear();
+    for (Entry& entry : entries)
+    {
+        const SenderName& name = senders[entry.sender];
+        auto it = senderIds.find(name);
+        if (it == senderIds.end())
+        {
+            it = senderIds.emplace(name, static_cast<uint16_t>(liveSenders.size())).first;
+            liveSenders.push_back(name);
+        }
+        entry.sender = it->second;
+    }
+    senders.swap(liveSenders);
+}
+
+void ChatBatch::clear()
+{
+    arena.clear();
+    entries.clear();
+    senders.clear();
+    senderIds.clear();
+}
+
+void ChatBatch::swap(ChatBatch& other)
+{
+    arena.swap(other.arena);
+    entries.swap(other.entries);
+    senders.swap(other.senders);
+    senderIds.swap(other.senderIds);
+}
+
+ChatMessageView ChatBatch::at(size_t index) const
+{
+    const Entry& entry = entries[index];
+    const char* raw = arena.data() + entry.rawOffset;
+
+    ChatMessageView view;
+    view.rawContent = std::string_view(raw, entry.rawLength);
+    view.message = std::string_view(raw + entry.messageStart, entry.messageLength);
+    view.senderPrefix = (entry.flags & SENT_TELL) ? "You >> " : std::string_view();
+    view.sender = senders[entry.sender].view();
+    view.type = entry.type;
+    view.timestampNs = entry.timestampNs;
+    return view;
+}
+
+ChatMessage ChatBatch::materialize(size_t index) const
+{
+    return at(index).materialize();
+}
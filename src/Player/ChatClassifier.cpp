@@ -0,0 +1,278 @@
+#include "Player/ChatClassifier.h"
+
+namespace {
+
+// Same set as \s for char in the "C" locale
+inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+inline bool isLetter(char c)
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+}
+
+inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline bool matchesAt(std::string_view line, size_t pos, std::string_view literal)
+{
+    return line.size() - pos >= literal.size() && line.compare(pos, literal.size(), literal) == 0;
+}
+
+// Markers that can appear anywhere in the line, collected in one scan
+struct LineMarkers {
+    size_t firstArrow = std::string_view::npos;  // First '>'
+    bool partyParens = false;                     // "(x...)" anywhere
+    bool innerTell = false;                       // ">>" preceded by something other than '>'
+    bool tellTarget = false;                      // ">>" followed by a non-blank
+    bool linkshell1 = false;                      // "[1]<"
+    bool linkshell2 = false;                      // "[2]<"
+    bool youFind = false;                         // "You find a"
+    bool obtains = false;                         // "obtains a"
+};
+
+LineMarkers scan(std::string_view line)
+{
+    LineMarkers markers;
+
+    // 0 = no open paren, 1 = '(' just seen, 2 = '(' followed by content
+    int paren = 0;
+
+    const size_t n = line.size();
+    for (size_t i = 0; i < n; i++)
+    {
+        char c = line[i];
+        switch (c)
+        {
+            case '(':
+                paren = (paren == 0) ? 1 : 2;
+                continue;
+
+            case ')':
+                if (paren == 2)
+                    markers.partyParens = true;
+                paren = 0;
+                continue;
+
+            case '>':
+                if (markers.firstArrow == std::string_view::npos)
+                    markers.firstArrow = i;
+                if (i + 1 < n && line[i + 1] == '>')
+                {
+                    if (i >= 1 && line[i - 1] != '>')
+                        markers.innerTell = true;
+                    if (i + 2 < n && !isSpace(line[i + 2]))
+                        markers.tellTarget = true;
+                }
+                break;
+
+            case '[':
+                if (matchesAt(line, i, "[1]<"))
+                    markers.linkshell1 = true;
+                else if (matchesAt(line, i, "[2]<"))
+                    markers.linkshell2 = true;
+                break;
+
+            case 'Y':
+                if (matchesAt(line, i, "You find a"))
+                    markers.youFind = true;
+                break;
+
+            case 'o':
+                if (matchesAt(line, i, "obtains a"))
+                    markers.obtains = true;
+                break;
+
+            default:
+                break;
+        }
+
+        if (paren == 1)
+            paren = 2;
+    }
+
+    return markers;
+}
+
+// ^\s*\([^)]+\)
+bool isLeadingParty(std::string_view line, size_t lead)
+{
+    if (lead + 1 >= line.size() || line[lead] != '(' || line[lead + 1] == ')')
+        return false;
+    return line.find(')', lead + 2) != std::string_view::npos;
+}
+
+// ^\s*>>\S
+bool isLeadingTellTarget(std::string_view line, size_t lead)
+{
+    return matchesAt(line, lead, ">>") && lead + 2 < line.size() && !isSpace(line[lead + 2]);
+}
+
+// ^\s*\{[^}]*[A-Za-z][^}]*\}
+bool isUnity(std::string_view line, size_t lead)
+{
+    if (lead >= line.size() || line[lead] != '{')
+        return false;
+
+    bool letter = false;
+    for (size_t i = lead + 1; i < line.size(); i++)
+    {
+        if (line[i] == '}')
+            return letter;
+        letter = letter || isLetter(line[i]);
+    }
+    return false;
+}
+
+// ^\s*[A-Za-z]+'?[A-Za-z]*\s+:\s+
+bool isSay(std::string_view line, size_t lead)
+{
+    const size_t n = line.size();
+    size_t i = lead;
+    while (i < n && isLetter(line[i]))
+        i++;
+    if (i == lead)
+        return false;
+    if (i < n && line[i] == '\'')
+    {
+        i++;
+        while (i < n && isLetter(line[i]))
+            i++;
+    }
+
+    size_t blanks = i;
+    while (i < n && isSpace(line[i]))
+        i++;
+    if (i == blanks || i >= n || line[i] != ':')
+        return false;
+    i++;
+    return i < n && isSpace(line[i]);
+}
+
+// ^\s*<[^>]+>
+bool isLeadingLinkshell(std::string_view line, size_t lead)
+{
+    if (lead + 1 >= line.size() || line[lead] != '<' || line[lead + 1] == '>')
+        return false;
+    return line.find('>', lead + 2) != std::string_view::npos;
+}
+
+// ^\s*[A-Za-z]+\s+(says|shouts|yells)\s*:
+ChatMessageType speechVerb(std::string_view line, size_t lead)
+{
+    const size_t n = line.size();
+    size_t i = lead;
+    while (i < n && isLetter(line[i]))
+        i++;
+    if (i == lead)
+        return ChatMessageType::Unknown;
+
+    size_t blanks = i;
+    while (i < n && isSpace(line[i]))
+        i++;
+    if (i == blanks)
+        return ChatMessageType::Unknown;
+
+    ChatMessageType type = ChatMessageType::Unknown;
+    if (matchesAt(line, i, "says"))
+    {
+        type = ChatMessageType::Say;
+        i += 4;
+    }
+    else if (matchesAt(line, i, "shouts"))
+    {
+        type = ChatMessageType::Shout;
+        i += 6;
+    }
+    else if (matchesAt(line, i, "yells"))
+    {
+        type = ChatMessageType::Yell;
+        i += 5;
+    }
+    else
+    {
+        return ChatMessageType::Unknown;
+    }
+
+    while (i < n && isSpace(line[i]))
+        i++;
+    return (i < n && line[i] == ':') ? type : ChatMessageType::Unknown;
+}
+
+// ^[A-Za-z]+\s+\d+:
+bool isTrial(std::string_view line)
+{
+    const size_t n = line.size();
+    size_t i = 0;
+    while (i < n && isLetter(line[i]))
+        i++;
+    if (i == 0)
+        return false;
+
+    size_t mark = i;
+    while (i < n && isSpace(line[i]))
+        i++;
+    if (i == mark)
+        return false;
+
+    mark = i;
+    while (i < n && isDigit(line[i]))
+        i++;
+    return i > mark && i < n && line[i] == ':';
+}
+
+} // namespace
+
+namespace ChatClassifier {
+
+ChatMessageType classify(std::string_view line)
+{
+    size_t lead = 0;
+    while (lead < line.size() && isSpace(line[lead]))
+        lead++;
+
+    const LineMarkers markers = scan(line);
+
+    // Priority order is the order of the original pattern list, plus the
+    // bare "<Name>" linkshell form and the "Name says:" forms of the log file
+    if (isLeadingParty(line, lead))
+        return ChatMessageType::Party;
+    if (matchesAt(line, lead, "You>>"))
+        return ChatMessageType::Tell;
+    if (markers.firstArrow != std::string_view::npos && markers.firstArrow >= 1 &&
+        markers.firstArrow + 1 < line.size() && line[markers.firstArrow + 1] == '>')
+        return ChatMessageType::Tell;
+    if (isLeadingTellTarget(line, lead))
+        return ChatMessageType::Tell;
+    if (markers.linkshell1)
+        return ChatMessageType::Linkshell1;
+    if (markers.linkshell2)
+        return ChatMessageType::Linkshell2;
+    if (isLeadingLinkshell(line, lead))
+        return ChatMessageType::Linkshell1;
+    if (markers.partyParens)
+        return ChatMessageType::Party;
+    if (markers.innerTell || markers.tellTarget)
+        return ChatMessageType::Tell;
+    if (isUnity(line, lead))
+        return ChatMessageType::Unity;
+    if (isSay(line, lead))
+        return ChatMessageType::Say;
+    ChatMessageType spoken = speechVerb(line, lead);
+    if (spoken != ChatMessageType::Unknown)
+        return spoken;
+    if (markers.youFind)
+        return ChatMessageType::Drops;
+    if (markers.obtains || matchesAt(line, 0, "Obtained key item:"))
+        return ChatMessageType::Obtained;
+    if (isTrial(line))
+        return ChatMessageType::Trial;
+
+    return ChatMessageType::Unknown;
+}
+
+} // namespace ChatClassifier
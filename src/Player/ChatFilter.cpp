@@ -0,0 +1,220 @@
+#include "Player/ChatFilter.h"
+#include <utility>
+
+namespace {
+
+inline unsigned char foldCase(unsigned char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+}
+
+inline size_t channelIndex(ChatMessageType type)
+{
+    return static_cast<size_t>(type);
+}
+
+} // namespace
+
+ChatFilter::SenderKey ChatFilter::senderKey(std::string_view name)
+{
+    char folded[SenderKey::capacity()];
+    size_t length = name.size() < sizeof(folded) ? name.size() : sizeof(folded);
+    for (size_t i = 0; i < length; i++)
+    {
+        folded[i] = static_cast<char>(foldCase(static_cast<unsigned char>(name[i])));
+    }
+    return SenderKey(std::string_view(folded, length));
+}
+
+bool ChatFilter::compile(const std::vector<ChatSubscription>& subscriptions, const std::vector<std::string>& characterNames)
+{
+    *this = ChatFilter();
+
+    subscriptionCount = subscriptions.size() < MAX_SUBSCRIPTIONS ? subscriptions.size() : MAX_SUBSCRIPTIONS;
+
+    std::vector<std::pair<std::string, uint64_t>> keywords;
+    for (size_t i = 0; i < subscriptionCount; i++)
+    {
+        const ChatSubscription& subscription = subscriptions[i];
+        uint64_t bit = uint64_t(1) << i;
+
+        for (size_t channel = 0; channel < CHANNEL_COUNT; channel++)
+        {
+            if (subscription.channels & (1u << channel))
+            {
+                channelSubscriptions[channel] |= bit;
+            }
+        }
+
+        if (subscription.senders.empty())
+        {
+            anySender |= bit;
+        }
+        for (const std::string& sender : subscription.senders)
+        {
+            senderSubscriptions[senderKey(sender)] |= bit;
+        }
+
+        if (!subscription.keywords.empty() || subscription.mentionsCharacter)
+        {
+            needsKeyword |= bit;
+        }
+        for (const std::string& keyword : subscription.keywords)
+        {
+            keywords.emplace_back(keyword, bit);
+        }
+        if (subscription.mentionsCharacter)
+        {
+            for (const std::string& name : characterNames)
+            {
+                keywords.emplace_back(name, bit);
+            }
+        }
+    }
+
+    buildAutomaton(keywords);
+    return subscriptionCount == subscriptions.size();
+}
+
+void ChatFilter::buildAutomaton(const std::vector<std::pair<std::string, uint64_t>>& keywords)
+{
+    // Bytes that occur in no pattern share class 0, so rows only need a
+    // column per distinct pattern byte (case folded)
+    for (const auto& keyword : keywords)
+    {
+        for (unsigned char c : keyword.first)
+        {
+            unsigned char folded = foldCase(c);
+            if (byteClass[folded] == 0 && classCount < 256)
+            {
+                byteClass[folded] = static_cast<uint8_t>(classCount++);
+            }
+        }
+    }
+    for (int c = 'A'; c <= 'Z'; c++)
+    {
+        byteClass[c] = byteClass[c - 'A' + 'a'];
+    }
+
+    // Trie; 0 is the root, so a 0 transition means "no child" until the
+    // automaton is completed below
+    transitions.assign(classCount, 0);
+    outputs.assign(1, 0);
+    for (const auto& keyword : keywords)
+    {
+        if (keyword.first.empty())
+        {
+            continue;
+        }
+
+        uint32_t state = 0;
+        for (unsigned char c : keyword.first)
+        {
+            uint32_t& next = transitions[state * classCount + byteClass[c]];
+            if (next == 0)
+            {
+                next = static_cast<uint32_t>(outputs.size());
+                outputs.push_back(0);
+                transitions.resize(transitions.size() + classCount, 0);
+            }
+            // transitions may have grown; re-read rather than keep the reference
+            state = transitions[state * classCount + byteClass[c]];
+        }
+        outputs[state] |= keyword.second;
+        patterns++;
+    }
+
+    // Breadth-first: each state's failure link is resolved before its
+    // children, so missing transitions are filled from it and outputs of
+    // suffix patterns are merged in, leaving a complete DFA
+    std::vector<uint32_t> failure(outputs.size(), 0);
+    std::vector<uint32_t> queue;
+    queue.reserve(outputs.size());
+    for (size_t c = 0; c < classCount; c++)
+    {
+        if (transitions[c] != 0)
+        {
+            queue.push_back(transitions[c]);
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        uint32_t state = queue[head];
+        uint32_t fail = failure[state];
+        outputs[state] |= outputs[fail];
+
+        for (size_t c = 0; c < classCount; c++)
+        {
+            uint32_t& next = transitions[state * classCount + c];
+            uint32_t fallback = transitions[fail * classCount + c];
+            if (next != 0)
+            {
+                failure[next] = fallback;
+                queue.push_back(next);
+            }
+            else
+            {
+                next = fallback;
+            }
+        }
+    }
+}
+
+uint64_t ChatFilter::scan(std::string_view text, uint64_t wanted) const
+{
+    uint64_t found = 0;
+    uint32_t state = 0;
+    const uint32_t* table = transitions.data();
+    for (unsigned char c : text)
+    {
+        state = table[state * classCount + byteClass[c]];
+        found |= outputs[state];
+        if (found & wanted)
+        {
+            break;
+        }
+    }
+    return found & wanted;
+}
+
+bool ChatFilter::matches(const ChatMessageView& msg) const
+{
+    if (subscriptionCount == 0)
+    {
+        return msg.type != ChatMessageType::Unknown;
+    }
+
+    size_t channel = channelIndex(msg.type);
+    if (channel >= CHANNEL_COUNT)
+    {
+        return false;
+    }
+
+    uint64_t candidates = channelSubscriptions[channel];
+    if (candidates == 0)
+    {
+        return false;
+    }
+
+    uint64_t senders = anySender;
+    if (!senderSubscriptions.empty())
+    {
+        auto it = senderSubscriptions.find(senderKey(msg.sender));
+        if (it != senderSubscriptions.end())
+        {
+            senders |= it->second;
+        }
+    }
+    candidates &= senders;
+
+    if (candidates & ~needsKeyword)
+    {
+        return true;
+    }
+    if (candidates == 0)
+    {
+        return false;
+    }
+    return scan(msg.message, candidates) != 0;
+}
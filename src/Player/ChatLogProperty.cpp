@@ -1,84 +1,17 @@
 #include "Player/ChatLogProperty.h"
+#include "Player/ChatParser.h"
 #include "Player/Player.h"
 #include "helpers/memory.h"
+#include "helpers/ffxitext.h"
 #include <iostream>
-#include <iomanip>
+#include <algorithm>
 #include <cstring>
 #include <cctype>
 #include <sstream>
 #include <Windows.h>
 
-// Helper function to convert Shift-JIS (Japanese) to UTF-8
-std::string ShiftJISToUTF8(const char* shiftjis, size_t length)
-{
-    if (length == 0) return "";
-
-    // Convert Shift-JIS (CP932) to wide char
-    int wideSize = MultiByteToWideChar(932, 0, shiftjis, length, nullptr, 0);
-    if (wideSize == 0) return std::string(shiftjis, length); // Fallback to original
-
-    std::wstring wideStr(wideSize, 0);
-    MultiByteToWideChar(932, 0, shiftjis, length, &wideStr[0], wideSize);
-
-    // Convert wide char to UTF-8
-    int utf8Size = WideCharToMultiByte(CP_UTF8, 0, wideStr.c_str(), wideSize, nullptr, 0, nullptr, nullptr);
-    if (utf8Size == 0) return std::string(shiftjis, length); // Fallback to original
-
-    std::string utf8Str(utf8Size, 0);
-    WideCharToMultiByte(CP_UTF8, 0, wideStr.c_str(), wideSize, &utf8Str[0], utf8Size, nullptr, nullptr);
-
-    return utf8Str;
-}
-
 ChatLogProperty::ChatLogProperty()
 {
-    initializePatterns();
-}
-
-void ChatLogProperty::initializePatterns()
-{
-    // Match FFXI chat formats (with optional leading space and special characters)
-    // Note: . matches any character (including special FFXI color codes)
-    // Order matters - more specific patterns should come first
-
-    // Party: (Name) Message or (ⁿName√) Message
-    chatPatterns.push_back({std::regex("^\\s*\\([^)]+\\)"), ChatMessageType::Party});
-
-    // Tell sent: You>> PlayerName : Message
-    chatPatterns.push_back({std::regex("^\\s*You>>"), ChatMessageType::Tell});
-
-    // Tell received: Name>> or ⁿName√>> or >>Name
-    chatPatterns.push_back({std::regex("^\\s*[^>]+>>"), ChatMessageType::Tell});
-    chatPatterns.push_back({std::regex("^\\s*>>[^\\s]"), ChatMessageType::Tell});
-
-    // Linkshell 1 and 2: [1]<Name> or [2]<Name> - CHECK FIRST
-    chatPatterns.push_back({std::regex("\\[1\\]<"), ChatMessageType::Linkshell1});
-    chatPatterns.push_back({std::regex("\\[2\\]<"), ChatMessageType::Linkshell2});
-
-    // Party: (Name) Message or (ⁿName√) Message
-    chatPatterns.push_back({std::regex("\\([^)]+\\)"), ChatMessageType::Party});
-
-    // Tell: Name>> or ⁿName√>> or >>Name
-    chatPatterns.push_back({std::regex("[^>]+>>"), ChatMessageType::Tell});
-    chatPatterns.push_back({std::regex(">>[^\\s]"), ChatMessageType::Tell});
-
-    // Unity: {Name} - must contain at least one letter (not just numbers like {3})
-    chatPatterns.push_back({std::regex("^\\s*\\{[^}]*[A-Za-z][^}]*\\}"), ChatMessageType::Unity});
-
-    // Say: Name : Message (must have space before and after colon)
-    chatPatterns.push_back({std::regex("^\\s*[A-Za-z]+'?[A-Za-z]*\\s+:\\s+"), ChatMessageType::Say});
-
-    // Drops: You find a
-    chatPatterns.push_back({std::regex("You find a"), ChatMessageType::Drops});
-
-    // Obtained: obtains a / Obtained key item:
-    chatPatterns.push_back({std::regex("obtains a"), ChatMessageType::Obtained});
-    chatPatterns.push_back({std::regex("^Obtained key item:"), ChatMessageType::Obtained});
-
-    // Trial: Name 123: (name followed by number and colon)
-    chatPatterns.push_back({std::regex("^[A-Za-z]+\\s+\\d+:"), ChatMessageType::Trial});
-
-    // Default to system for anything else
 }
 
 void ChatLogProperty::RegisterCallback(ChatCallback callback)
@@ -91,314 +24,62 @@ void ChatLogProperty::UnregisterCallback()
     chatCallback = nullptr;
 }
 
-// Helper function to remove FFXI special characters (color codes, etc.)
-std::string ChatLogProperty::CleanFFXIString(const std::string& input)
+namespace
 {
-    std::string result;
-    for (unsigned char c : input)
+    // Trim both ends; a line that is all blanks is left as it is
+    std::string_view trimView(std::string_view text, const char* blanks)
     {
-        // Only keep printable ASCII characters (space through ~)
-        if (c >= 0x20 && c <= 0x7E)
+        size_t start = text.find_first_not_of(blanks);
+        size_t end = text.find_last_not_of(blanks);
+        if (start == std::string_view::npos || end == std::string_view::npos)
         {
-            result += c;
+            return text;
         }
+        return text.substr(start, end - start + 1);
     }
-    return result;
-}
-
-ChatMessageType ChatLogProperty::DetermineChatType(const std::string& line)
-{
-    // Debug: print what we're trying to match
-    std::cout << "[ChatLog] Determining type for: \"" << line << "\"" << std::endl;
 
-    // Debug: Check if linkshell pattern exists as substring
-    if (line.find("[2]<") != std::string::npos)
+    // FNV-1a; only used to tell one probe from the next
+    uint64_t hashBytes(const char* data, size_t length)
     {
-        std::cout << "[ChatLog] Found [2]< substring!" << std::endl;
-    }
-    if (line.find("[1]<") != std::string::npos)
-    {
-        std::cout << "[ChatLog] Found [1]< substring!" << std::endl;
-    }
-
-    // Try each pattern in order
-    int patternIndex = 0;
-    for (const auto& pattern : chatPatterns)
-    {
-        try {
-            if (std::regex_search(line, pattern.pattern))
-            {
-                std::cout << "[ChatLog] Matched pattern " << patternIndex << std::endl;
-                return pattern.type;
-            }
-        } catch (const std::regex_error& e) {
-            std::cout << "[ChatLog] Regex error at pattern " << patternIndex << ": " << e.what() << std::endl;
+        uint64_t h = 0xcbf29ce484222325ULL;
+        for (size_t i = 0; i < length; i++)
+        {
+            h ^= static_cast<unsigned char>(data[i]);
+            h *= 0x100000001b3ULL;
         }
-        patternIndex++;
+        return h;
     }
-
-    // Default to unknown if no pattern matches
-    std::cout << "[ChatLog] No pattern matched - returning Unknown" << std::endl;
-    return ChatMessageType::Unknown;
 }
 
-ChatMessage ChatLogProperty::ParseChatLine(const std::string& line)
+bool ChatLogProperty::ReadChatLine(HANDLE hProcess, uintptr_t address, const char* probe, size_t& length)
 {
-    ChatMessage msg;
-
-    if (line.empty())
-    {
-        return msg;
-    }
-
-    // Determine chat type using regex patterns
-    msg.type = DetermineChatType(line);
-    msg.timestamp = std::time(nullptr);
-
-    // Extract sender and message based on type
-    std::string trimmedLine = line;
-
-    // Remove leading/trailing whitespace
-    size_t start = trimmedLine.find_first_not_of(" \t\r\n");
-    size_t end = trimmedLine.find_last_not_of(" \t\r\n");
-    if (start != std::string::npos && end != std::string::npos)
-    {
-        trimmedLine = trimmedLine.substr(start, end - start + 1);
-    }
-
-    // Store the original raw content (after trimming)
-    msg.rawContent = trimmedLine;
-
-    switch (msg.type)
+    // Lines are usually short: the probe, then up to 512 bytes, then the whole buffer
+    rawBuffer.assign(probe, PROBE_SIZE);
+    size_t scanned = 0;
+    while (true)
     {
-        case ChatMessageType::Party:
-        {
-            // Format: (ⁿSenderName√) Message or (SenderName) Message
-            size_t openParen = trimmedLine.find('(');
-            size_t closeParen = trimmedLine.find(')');
-            if (openParen != std::string::npos && closeParen != std::string::npos)
-            {
-                std::string rawSender = trimmedLine.substr(openParen + 1, closeParen - openParen - 1);
-                msg.sender = CleanFFXIString(rawSender);
-                msg.message = trimmedLine.substr(closeParen + 1);
-                // Trim message
-                size_t msgStart = msg.message.find_first_not_of(" \t");
-                if (msgStart != std::string::npos)
-                {
-                    msg.message = msg.message.substr(msgStart);
-                }
-            }
-            break;
-        }
-
-        case ChatMessageType::Tell:
-        {
-            // Format: ⁿSenderName√>> Message or SenderName>> Message or You>> RecipientName : Message or >>RecipientName : Message
-            size_t arrowPos = trimmedLine.find(">>");
-            if (arrowPos != std::string::npos)
-            {
-                if (arrowPos == 0)
-                {
-                    // Sent tell format: >>RecipientName : Message
-                    std::cout << "[ChatLog] Parsing sent tell (>> at start)" << std::endl;
-                    std::string afterArrow = trimmedLine.substr(2); // Skip the >>
-                    std::cout << "[ChatLog] After arrow: '" << afterArrow << "'" << std::endl;
-                    size_t colonPos = afterArrow.find(':');
-                    std::cout << "[ChatLog] Colon position: " << colonPos << std::endl;
-                    if (colonPos != std::string::npos)
-                    {
-                        std::string recipient = afterArrow.substr(0, colonPos);
-                        std::cout << "[ChatLog] Recipient before trim: '" << recipient << "'" << std::endl;
-                        // Trim recipient name
-                        size_t nameStart = recipient.find_first_not_of(" \t");
-                        if (nameStart != std::string::npos)
-                        {
-                            recipient = recipient.substr(nameStart);
-                            size_t nameEnd = recipient.find_last_not_of(" \t");
-                            if (nameEnd != std::string::npos)
-                            {
-                                recipient = recipient.substr(0, nameEnd + 1);
-                            }
-                        }
-                        std::cout << "[ChatLog] Recipient after trim: '" << recipient << "'" << std::endl;
-                        msg.sender = "You >> " + CleanFFXIString(recipient);
-                        msg.message = afterArrow.substr(colonPos + 1);
-                        std::cout << "[ChatLog] Message before trim: '" << msg.message << "'" << std::endl;
-                        // Trim message
-                        size_t msgStart = msg.message.find_first_not_of(" \t");
-                        if (msgStart != std::string::npos)
-                        {
-                            msg.message = msg.message.substr(msgStart);
-                        }
-                        std::cout << "[ChatLog] Message after trim: '" << msg.message << "'" << std::endl;
-                        std::cout << "[ChatLog] Sender: '" << msg.sender << "'" << std::endl;
-                    }
-                }
-                else
-                {
-                    std::string rawSender = trimmedLine.substr(0, arrowPos);
-
-                    // Check if this is a sent tell (You>>)
-                    if (rawSender == "You")
-                    {
-                        // Sent tell: You>> RecipientName : Message
-                        std::string afterArrow = trimmedLine.substr(arrowPos + 2);
-                        size_t colonPos = afterArrow.find(':');
-                        if (colonPos != std::string::npos)
-                        {
-                            std::string recipient = afterArrow.substr(0, colonPos);
-                            // Trim recipient name
-                            size_t nameStart = recipient.find_first_not_of(" \t");
-                            if (nameStart != std::string::npos)
-                            {
-                                recipient = recipient.substr(nameStart);
-                                size_t nameEnd = recipient.find_last_not_of(" \t");
-                                if (nameEnd != std::string::npos)
-                                {
-                                    recipient = recipient.substr(0, nameEnd + 1);
-                                }
-                            }
-                            msg.sender = "You >> " + CleanFFXIString(recipient);
-                            msg.message = afterArrow.substr(colonPos + 1);
-                            // Trim message
-                            size_t msgStart = msg.message.find_first_not_of(" \t");
-                            if (msgStart != std::string::npos)
-                            {
-                                msg.message = msg.message.substr(msgStart);
-                            }
-                        }
-                    }
-                    else
-                    {
-                        // Received tell
-                        msg.sender = CleanFFXIString(rawSender);
-                        msg.message = trimmedLine.substr(arrowPos + 2);
-                        // Trim message
-                        size_t msgStart = msg.message.find_first_not_of(" \t");
-                        if (msgStart != std::string::npos)
-                        {
-                            msg.message = msg.message.substr(msgStart);
-                        }
-                    }
-                }
-            }
-            break;
-        }
-        case ChatMessageType::Linkshell1:
-        case ChatMessageType::Linkshell2:
-        {
-            // Format: [1]<ⁿSenderName√> Message or [2]<ⁿSenderName√> Message
-            size_t openBracket = trimmedLine.find('<');
-            size_t closeBracket = trimmedLine.find('>');
-            if (openBracket != std::string::npos && closeBracket != std::string::npos)
-            {
-                std::string rawSender = trimmedLine.substr(openBracket + 1, closeBracket - openBracket - 1);
-                msg.sender = CleanFFXIString(rawSender);
-                msg.message = trimmedLine.substr(closeBracket + 1);
-                // Trim message
-                size_t msgStart = msg.message.find_first_not_of(" \t");
-                if (msgStart != std::string::npos)
-                {
-                    msg.message = msg.message.substr(msgStart);
-                }
-            }
-            break;
-        }
-
-        case ChatMessageType::Say:
-        {
-            // Format: SenderName : Message (space colon space)
-            size_t colonPos = trimmedLine.find(" : ");
-            if (colonPos != std::string::npos)
-            {
-                std::string rawSender = trimmedLine.substr(0, colonPos);
-                msg.sender = CleanFFXIString(rawSender);
-                msg.message = trimmedLine.substr(colonPos + 3); // +3 to skip " : "
-            }
-            break;
-        }
-
-        case ChatMessageType::Shout:
-        {
-            // Format: [SenderName] : Message
-            size_t openBracket = trimmedLine.find('[');
-            size_t closeBracket = trimmedLine.find(']');
-            if (openBracket != std::string::npos && closeBracket != std::string::npos)
-            {
-                std::string rawSender = trimmedLine.substr(openBracket + 1, closeBracket - openBracket - 1);
-                msg.sender = CleanFFXIString(rawSender);
-                size_t colonPos = trimmedLine.find(':', closeBracket);
-                if (colonPos != std::string::npos)
-                {
-                    msg.message = trimmedLine.substr(colonPos + 1);
-                    // Trim message
-                    size_t msgStart = msg.message.find_first_not_of(" \t");
-                    if (msgStart != std::string::npos)
-                    {
-                        msg.message = msg.message.substr(msgStart);
-                    }
-                }
-            }
-            break;
-        }
-
-        case ChatMessageType::Yell:
+        const void* terminator = std::memchr(rawBuffer.data() + scanned, '\0', rawBuffer.size() - scanned);
+        if (terminator)
         {
-            // Format: SenderName[Zone]: Message
-            size_t openBracket = trimmedLine.find('[');
-            if (openBracket != std::string::npos)
-            {
-                std::string rawSender = trimmedLine.substr(0, openBracket);
-                msg.sender = CleanFFXIString(rawSender);
-                size_t colonPos = trimmedLine.find(':', openBracket);
-                if (colonPos != std::string::npos)
-                {
-                    msg.message = trimmedLine.substr(colonPos + 1);
-                    // Trim message
-                    size_t msgStart = msg.message.find_first_not_of(" \t");
-                    if (msgStart != std::string::npos)
-                    {
-                        msg.message = msg.message.substr(msgStart);
-                    }
-                }
-            }
-            break;
+            length = static_cast<const char*>(terminator) - rawBuffer.data();
+            return true;
         }
 
-        case ChatMessageType::Unity:
+        scanned = rawBuffer.size();
+        if (scanned >= static_cast<size_t>(CHAT_BUFFER_SIZE))
         {
-            // Format: {ⁿSenderName√} Message or {SenderName} Message
-            size_t openBrace = trimmedLine.find('{');
-            size_t closeBrace = trimmedLine.find('}');
-            if (openBrace != std::string::npos && closeBrace != std::string::npos)
-            {
-                std::string rawSender = trimmedLine.substr(openBrace + 1, closeBrace - openBrace - 1);
-                msg.sender = CleanFFXIString(rawSender);
-                msg.message = trimmedLine.substr(closeBrace + 1);
-                // Trim message
-                size_t msgStart = msg.message.find_first_not_of(" \t");
-                if (msgStart != std::string::npos)
-                {
-                    msg.message = msg.message.substr(msgStart);
-                }
-            }
-            break;
+            // Unterminated: take the whole buffer, as before
+            length = scanned;
+            return true;
         }
 
-        case ChatMessageType::Drops:
-        case ChatMessageType::Obtained:
-        case ChatMessageType::Trial:
-        case ChatMessageType::System:
-        default:
+        size_t next = std::min(scanned * 8, static_cast<size_t>(CHAT_BUFFER_SIZE));
+        rawBuffer.resize(next);
+        if (!ReadProcessMemory(hProcess, (LPCVOID)(address + scanned), &rawBuffer[scanned], next - scanned, nullptr))
         {
-            // System messages - entire line is the message
-            msg.sender = "System";
-            msg.message = trimmedLine;
-            break;
+            return false;
         }
     }
-
-    return msg;
 }
 
 void ChatLogProperty::refresh(const PlayerProcessInfo& processInfo)
@@ -425,74 +106,30 @@ void ChatLogProperty::refresh(const PlayerProcessInfo& processInfo)
     // Step 3: Read from base pointer (offset 0x00) - this contains the complete message
     uintptr_t chatAddress = chatPointer + CHAT_LOG_OFFSET;
 
-    // Read chat buffer from memory
-    char chatBuffer[CHAT_BUFFER_SIZE];
-    memset(chatBuffer, 0, CHAT_BUFFER_SIZE);
-
-    if (!ReadProcessMemory(processInfo.hProcess, (LPCVOID)chatAddress,
-        chatBuffer, CHAT_BUFFER_SIZE, nullptr))
+    // Change probe: hash the first cache line. Most refreshes see the same line and stop here
+    char probe[PROBE_SIZE];
+    if (!ReadProcessMemory(processInfo.hProcess, (LPCVOID)chatAddress, probe, PROBE_SIZE, nullptr))
     {
         // Failed to read - not an error, just skip
         return;
     }
 
-    // MEMORY ANALYSIS: Dump first 512 bytes to analyze structure
-    // Look for "AAAA" pattern to study memory layout
-    bool foundLorem = false;
-    for (size_t i = 0; i < CHAT_BUFFER_SIZE - 4; i++)
-    {
-        if (chatBuffer[i] == 'A' && chatBuffer[i+1] == 'A' && chatBuffer[i+2] == 'A' &&
-            chatBuffer[i+3] == 'A')
-        {
-            foundLorem = true;
-            break;
-        }
-    }
-
-    if (foundLorem)
+    uint64_t probeHash = hashBytes(probe, PROBE_SIZE);
+    ChatCursor& cursor = cursors[procId];
+    if (cursor.address == chatAddress && cursor.probeHash == probeHash)
     {
-        std::cout << "\n========== MEMORY ANALYSIS: FOUND AAAA PATTERN ==========" << std::endl;
-        std::cout << "Chat Address: 0x" << std::hex << chatAddress << std::dec << std::endl;
-        std::cout << "Base Pointer: 0x" << std::hex << chatPointer << std::dec << std::endl;
-
-        // Dump first 512 bytes in hex + ASCII
-        for (size_t i = 0; i < 512 && i < CHAT_BUFFER_SIZE; i += 16)
-        {
-            // Print offset
-            std::cout << std::hex << std::setw(4) << std::setfill('0') << i << ": ";
-
-            // Print hex bytes
-            for (size_t j = 0; j < 16 && (i + j) < 512; j++)
-            {
-                unsigned char c = (unsigned char)chatBuffer[i + j];
-                std::cout << std::hex << std::setw(2) << std::setfill('0') << (int)c << " ";
-            }
-
-            // Print ASCII representation
-            std::cout << " | ";
-            for (size_t j = 0; j < 16 && (i + j) < 512; j++)
-            {
-                unsigned char c = (unsigned char)chatBuffer[i + j];
-                if (c >= 0x20 && c <= 0x7E)
-                    std::cout << c;
-                else if (c == 0x00)
-                    std::cout << ".";
-                else
-                    std::cout << "?";
-            }
-            std::cout << std::dec << std::endl;
-        }
-        std::cout << "========== END MEMORY DUMP ==========" << std::endl << std::endl;
+        return;
     }
 
-    // Find the length of the string (up to first null terminator)
+    // Only read as much of the buffer as the new line needs
     size_t bufferLength = 0;
-    for (size_t i = 0; i < CHAT_BUFFER_SIZE; i++)
+    if (!ReadChatLine(processInfo.hProcess, chatAddress, probe, bufferLength))
     {
-        if (chatBuffer[i] == '\0')
-            break;
-        bufferLength++;
+        // Leave the cursor alone so the next refresh tries again
+        return;
     }
+    cursor.address = chatAddress;
+    cursor.probeHash = probeHash;
 
     if (bufferLength == 0)
     {
@@ -500,45 +137,25 @@ void ChatLogProperty::refresh(const PlayerProcessInfo& processInfo)
         return;
     }
 
-    // Remove FFXI control characters (0x01-0x1F, 0x7F-0x9F) before conversion
-    // These are formatting/color codes that interfere with text encoding
-    std::string cleanedBuffer;
-    cleanedBuffer.reserve(bufferLength);
-
-    for (size_t i = 0; i < bufferLength; i++)
-    {
-        unsigned char c = (unsigned char)chatBuffer[i];
-
-        // Keep printable ASCII (0x20-0x7E) and high bytes for Japanese text (0xA0+)
-        // Remove control characters (0x01-0x1F) and extended control chars (0x7F-0x9F)
-        if ((c >= 0x20 && c <= 0x7E) || c >= 0xA0)
-        {
-            cleanedBuffer += c;
-        }
-    }
-
-    // The text appears to already be in ASCII/UTF-8, not Shift-JIS
-    // Just use the cleaned buffer directly
-    std::string currentContent = cleanedBuffer;
+    // Remove FFXI control and colour codes (with their parameter bytes); Shift-JIS text is kept
+    // and becomes UTF-8 when it is serialized. The buffer is reused across ticks, so this does
+    // not allocate once warmed up
+    cleanedBuffer.clear();
+    FFXIText::decode(std::string_view(rawBuffer.data(), bufferLength), FFXIText::Profile::Chat, cleanedBuffer);
 
-    // Trim whitespace
-    size_t start = currentContent.find_first_not_of(" \t\r\n");
-    size_t end = currentContent.find_last_not_of(" \t\r\n");
-    if (start != std::string::npos && end != std::string::npos)
-    {
-        currentContent = currentContent.substr(start, end - start + 1);
-    }
+    // Everything below narrows a view of the cleaned buffer instead of copying it
+    std::string_view currentContent = trimView(cleanedBuffer, " \t\r\n");
 
     // Remove FFXI in-game timestamp prefix (e.g., "j[4:32:53pm] ")
     // Pattern: starts with 'j' or other char, followed by [timestamp]
     if (currentContent.length() > 0 && currentContent[0] == 'j' && currentContent.find('[') == 1)
     {
         size_t closeBracket = currentContent.find(']');
-        if (closeBracket != std::string::npos)
+        if (closeBracket != std::string_view::npos)
         {
             // Check if this looks like a timestamp by looking for colons
-            std::string potentialTimestamp = currentContent.substr(2, closeBracket - 2);
-            if (potentialTimestamp.find(':') != std::string::npos)
+            std::string_view potentialTimestamp = currentContent.substr(2, closeBracket - 2);
+            if (potentialTimestamp.find(':') != std::string_view::npos)
             {
                 // Remove the timestamp prefix including the space after ]
                 size_t removeUntil = closeBracket + 1;
@@ -546,7 +163,7 @@ void ChatLogProperty::refresh(const PlayerProcessInfo& processInfo)
                 {
                     removeUntil++;
                 }
-                currentContent = currentContent.substr(removeUntil);
+                currentContent.remove_prefix(removeUntil);
             }
         }
     }
@@ -561,7 +178,7 @@ void ChatLogProperty::refresh(const PlayerProcessInfo& processInfo)
         if (first == second || (std::tolower(first) == std::tolower(second) && std::isupper(second)))
         {
             // Remove the duplicate first character
-            currentContent = currentContent.substr(1);
+            currentContent.remove_prefix(1);
         }
     }
 
@@ -572,14 +189,14 @@ void ChatLogProperty::refresh(const PlayerProcessInfo& processInfo)
     {
         size_t len = currentContent.length();
         // Check if ends with .<digit>
-        if (len >= 2 && currentContent[len - 2] == '.' &&
+        if (currentContent[len - 2] == '.' &&
             currentContent[len - 1] >= '0' && currentContent[len - 1] <= '9')
         {
             // Remove only the digit, keep the period
-            currentContent = currentContent.substr(0, len - 1);
+            currentContent.remove_suffix(1);
             // Trim any trailing whitespace that might be left
-            end = currentContent.find_last_not_of(" \t\r\n");
-            if (end != std::string::npos)
+            size_t end = currentContent.find_last_not_of(" \t\r\n");
+            if (end != std::string_view::npos)
             {
                 currentContent = currentContent.substr(0, end + 1);
             }
@@ -587,13 +204,11 @@ void ChatLogProperty::refresh(const PlayerProcessInfo& processInfo)
     }
 
     // Check if content has changed
-    if (lastChatContent.find(procId) != lastChatContent.end())
+    std::string& lastContent = lastChatContent[procId];
+    if (lastContent == currentContent)
     {
-        if (lastChatContent[procId] == currentContent)
-        {
-            // No change
-            return;
-        }
+        // No change
+        return;
     }
 
     // Content changed - this is a new message!
@@ -603,11 +218,11 @@ void ChatLogProperty::refresh(const PlayerProcessInfo& processInfo)
         std::cout << "[ChatLog] Raw content: " << currentContent << std::endl;
 
         // Parse the message
-        ChatMessage msg = ParseChatLine(currentContent);
+        ChatMessageView msg = ChatParser::parse(currentContent);
 
         if (!msg.message.empty())
         {
-            std::cout << "[ChatLog] Parsed - Sender: " << msg.sender
+            std::cout << "[ChatLog] Parsed - Sender: " << msg.senderPrefix << msg.sender
                       << ", Type: " << msg.getMessageTypeString()
                       << ", Message: " << msg.message << std::endl;
 
@@ -619,6 +234,6 @@ void ChatLogProperty::refresh(const PlayerProcessInfo& processInfo)
         }
     }
 
-    // Update last content
-    lastChatContent[procId] = currentContent;
+    // Update last content (reuses the string's capacity)
+    lastContent.assign(currentContent.data(), currentContent.size());
 }
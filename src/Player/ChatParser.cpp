@@ -0,0 +1,190 @@
+#include "Player/ChatParser.h"
+#include "Player/ChatClassifier.h"
+#include <chrono>
+
+namespace {
+
+// Trim both ends; a line that is all blanks is left as it is
+std::string_view trimView(std::string_view text, const char* blanks)
+{
+    size_t start = text.find_first_not_of(blanks);
+    size_t end = text.find_last_not_of(blanks);
+    if (start == std::string_view::npos || end == std::string_view::npos)
+    {
+        return text;
+    }
+    return text.substr(start, end - start + 1);
+}
+
+std::string_view trimLeading(std::string_view text)
+{
+    size_t start = text.find_first_not_of(" \t");
+    return (start != std::string_view::npos) ? text.substr(start) : text;
+}
+
+// Sender and message between an opening and closing delimiter: "(Name) Message", "<Name> Message", "{Name} Message"
+void parseEnclosed(std::string_view line, char open, char close, ChatMessageView& msg)
+{
+    size_t openPos = line.find(open);
+    if (openPos == std::string_view::npos)
+    {
+        return;
+    }
+    size_t closePos = line.find(close, openPos + 1);
+    if (closePos == std::string_view::npos)
+    {
+        return;
+    }
+    msg.sender = line.substr(openPos + 1, closePos - openPos - 1);
+    msg.message = trimLeading(line.substr(closePos + 1));
+}
+
+// "Name : Message", "Name says: Message", "Name shouts: Message", "[Name] : Message", "Name[Zone]: Message"
+void parseSpoken(std::string_view line, ChatMessageView& msg)
+{
+    size_t colonPos = line.find(':');
+    if (colonPos == std::string_view::npos)
+    {
+        return;
+    }
+
+    std::string_view sender = trimView(line.substr(0, colonPos), " \t");
+    if (!sender.empty() && sender.front() == '[')
+    {
+        size_t closeBracket = sender.find(']');
+        sender = sender.substr(1, (closeBracket != std::string_view::npos ? closeBracket : sender.size()) - 1);
+    }
+    else
+    {
+        size_t zone = sender.find('[');
+        if (zone != std::string_view::npos)
+        {
+            sender = sender.substr(0, zone);
+        }
+
+        size_t space = sender.find_last_of(" \t");
+        if (space != std::string_view::npos)
+        {
+            std::string_view verb = sender.substr(space + 1);
+            if (verb == "says" || verb == "shouts" || verb == "yells")
+            {
+                sender = trimView(sender.substr(0, space), " \t");
+            }
+        }
+    }
+
+    msg.sender = sender;
+    msg.message = trimLeading(line.substr(colonPos + 1));
+}
+
+// "Name>> Message" (received), "You>> Name : Message" or ">>Name : Message" (sent)
+void parseTell(std::string_view line, ChatMessageView& msg)
+{
+    size_t arrowPos = line.find(">>");
+    if (arrowPos == std::string_view::npos)
+    {
+        return;
+    }
+
+    std::string_view rawSender = trimView(line.substr(0, arrowPos), " \t");
+    if (arrowPos == 0 || rawSender == "You")
+    {
+        std::string_view afterArrow = line.substr(arrowPos + 2);
+        size_t colonPos = afterArrow.find(':');
+        if (colonPos != std::string_view::npos)
+        {
+            msg.senderPrefix = "You >> ";
+            msg.sender = trimView(afterArrow.substr(0, colonPos), " \t");
+            msg.message = trimLeading(afterArrow.substr(colonPos + 1));
+        }
+        return;
+    }
+
+    msg.sender = rawSender;
+    msg.message = trimLeading(line.substr(arrowPos + 2));
+}
+
+// Channels whose lines name a sender
+bool hasSender(ChatMessageType type)
+{
+    switch (type)
+    {
+        case ChatMessageType::Say:
+        case ChatMessageType::Shout:
+        case ChatMessageType::Tell:
+        case ChatMessageType::Party:
+        case ChatMessageType::Linkshell1:
+        case ChatMessageType::Linkshell2:
+        case ChatMessageType::Yell:
+        case ChatMessageType::Unity:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+namespace ChatParser {
+
+ChatMessageView parse(std::string_view line)
+{
+    ChatMessageView msg;
+    msg.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::string_view trimmedLine = trimView(line, " \t\r\n");
+    if (trimmedLine.empty())
+    {
+        return msg;
+    }
+
+    msg.type = ChatClassifier::classify(trimmedLine);
+    msg.rawContent = trimmedLine;
+
+    switch (msg.type)
+    {
+        case ChatMessageType::Party:
+            parseEnclosed(trimmedLine, '(', ')', msg);
+            break;
+
+        case ChatMessageType::Tell:
+            parseTell(trimmedLine, msg);
+            break;
+
+        case ChatMessageType::Linkshell1:
+        case ChatMessageType::Linkshell2:
+            parseEnclosed(trimmedLine, '<', '>', msg);
+            break;
+
+        case ChatMessageType::Unity:
+            parseEnclosed(trimmedLine, '{', '}', msg);
+            break;
+
+        case ChatMessageType::Say:
+        case ChatMessageType::Shout:
+        case ChatMessageType::Yell:
+            parseSpoken(trimmedLine, msg);
+            break;
+
+        default:
+            // Drops, trial counters and unrecognised lines have no sender
+            break;
+    }
+
+    if (msg.sender.empty() || msg.message.empty())
+    {
+        // A channel whose sender could not be found is demoted to a system line
+        if (hasSender(msg.type))
+        {
+            msg.type = ChatMessageType::System;
+        }
+        msg.senderPrefix = std::string_view();
+        msg.sender = "System";
+        msg.message = trimmedLine;
+    }
+
+    return msg;
+}
+
+} // namespace ChatParser
@@ -0,0 +1,112 @@
+#include "Player/DerivedProperty.h"
+#include <iostream>
+#include <sstream>
+
+DerivedProperty::DerivedProperty(const std::string &name,
+                                 std::vector<std::shared_ptr<PlayerProperty>> inputs,
+                                 ComputeFunc compute,
+                                 const std::string &endpoint)
+	: name(name), endpoint(endpoint), inputs(std::move(inputs)), compute(std::move(compute))
+{
+}
+
+void DerivedProperty::refresh(const PlayerProcessInfo &process)
+{
+	DWORD procId = process.procId;
+
+	// Snapshot input versions (each input locks its own mutex)
+	std::vector<uint64_t> currentVersions;
+	currentVersions.reserve(inputs.size());
+	for (const auto &input : inputs)
+	{
+		currentVersions.push_back(input->getVersion(procId));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(propertyMutex);
+		auto it = inputVersions.find(procId);
+		if (it != inputVersions.end() && it->second == currentVersions)
+		{
+			// No input changed since the last evaluation
+			return;
+		}
+	}
+
+	std::vector<long long> inputValues;
+	inputValues.reserve(inputs.size());
+	for (const auto &input : inputs)
+	{
+		inputValues.push_back(input->getNumericValue(procId));
+	}
+
+	long long result = compute ? compute(procId, inputValues) : 0;
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	inputVersions[procId] = std::move(currentVersions);
+
+	auto valueIt = values.find(procId);
+	if (valueIt == values.end() || valueIt->second != result)
+	{
+		values[procId] = result;
+		bumpVersion(procId); // Propagates to properties derived from this one
+	}
+}
+
+const char *DerivedProperty::getPropertyName() const
+{
+	return name.c_str();
+}
+
+void DerivedProperty::displayValue(DWORD procId) const
+{
+	std::cout << getNumericValue(procId);
+}
+
+long long DerivedProperty::getNumericValue(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = values.find(procId);
+	return (it != values.end()) ? it->second : 0;
+}
+
+const std::vector<std::shared_ptr<PlayerProperty>> &DerivedProperty::getInputs() const
+{
+	return inputs;
+}
+
+bool DerivedProperty::hasChanged(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = values.find(procId);
+	return (it != values.end()) && passesChangePolicy(procId, it->second);
+}
+
+void DerivedProperty::acknowledgeChange(DWORD procId)
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = values.find(procId);
+	if (it != values.end())
+	{
+		recordReportedValue(procId, it->second);
+	}
+}
+
+void DerivedProperty::reportChange(DWORD procId) const
+{
+	if (!g_playerInstance || endpoint.empty())
+	{
+		return;
+	}
+
+	long long value = getNumericValue(procId);
+
+	std::ostringstream jsonPayload;
+	jsonPayload << "{"
+	           << "\"playerName\":\"" << escapeJsonString(g_playerInstance->getPlayerName(procId)) << "\","
+	           << "\"playerId\":" << g_playerInstance->getPlayerId(procId) << ","
+	           << "\"property\":\"" << escapeJsonString(name) << "\","
+	           << "\"value\":" << value
+	           << "}";
+
+	g_playerInstance->getChangePublisher().publish(procId, name, endpoint, jsonPayload.str());
+}
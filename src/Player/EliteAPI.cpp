@@ -1,11 +1,12 @@
 #include "Player/EliteAPI.h"
 #include "Player/ChatMessage.h"
+#include "Player/ChatBatch.h"
+#include "Player/ChatParser.h"
 #include "helpers/logger.h"
+#include "helpers/ffxitext.h"
 #include <iostream>
 #include <thread>
 #include <mutex>
-#include <deque>
-#include "helpers/http.h"
 
 // Elite API function type definitions
 // FIXED: Elite API uses __stdcall convention (Windows standard)
@@ -140,9 +141,12 @@ private:
     std::thread chatMonitorThread;
     std::mutex chatMutex;
     std::mutex dllCallMutex;  // Protects all DLL function calls for thread safety
-    std::deque<ChatMessage> recentMessages;
+    ChatBatch recentMessages;  // Last RECENT_MESSAGE_LIMIT messages, copied once into one arena
     EliteAPI::ChatCallback chatCallback;
     int lastProcessedChatLine;
+    std::string cleanLine;     // Reused per line; parsed views point into it
+
+    static const size_t RECENT_MESSAGE_LIMIT = 100;
 
 public:
     EliteAPIImpl()
@@ -301,7 +305,7 @@ public:
 
         for (size_t i = start; i < recentMessages.size(); i++)
         {
-            messages.push_back(recentMessages[i]);
+            messages.push_back(recentMessages.materialize(i));
         }
 
         return messages;
@@ -528,22 +532,10 @@ public:
             std::cout << std::endl;
             std::cout << "[EliteAPI] DEBUG Raw String: " << rawLine << std::endl;
 
-            ChatMessage msg;
-            msg.timestamp = std::time(nullptr);
-            msg.type = ChatMessageType::System; // Default to system
-            msg.rawContent = rawLine;
-
-            std::string line(rawLine);
-
-            // Clean up the line - remove special characters
-            std::string cleanLine;
-            for (char c : line)
-            {
-                if (c >= 32 && c <= 126) // Printable ASCII only
-                {
-                    cleanLine += c;
-                }
-            }
+            // Clean up the line - control codes and their parameters out, Shift-JIS text kept
+            // (it is transcoded to UTF-8 when the message is serialized)
+            cleanLine.clear();
+            FFXIText::decode(rawLine, FFXIText::Profile::Chat, cleanLine);
             
             std::cout << "[EliteAPI] DEBUG Clean String: " << cleanLine << std::endl;
 
@@ -552,57 +544,8 @@ public:
                 return;
             }
 
-            // Parse message type and sender
-            // Format: (PlayerName) Message (Party)
-            if (cleanLine.front() == '(')
-            {
-                size_t closeParen = cleanLine.find(") ");
-                if (closeParen != std::string::npos)
-                {
-                    msg.type = ChatMessageType::Party;
-                    msg.sender = cleanLine.substr(1, closeParen - 1);
-                    msg.message = cleanLine.substr(closeParen + 2);
-                }
-            }
-            // Format: <PlayerName> Message (Linkshell)
-            else if (cleanLine.front() == '<')
-            {
-                size_t closeBracket = cleanLine.find("> ");
-                if (closeBracket != std::string::npos)
-                {
-                    msg.type = ChatMessageType::Linkshell1;
-                    msg.sender = cleanLine.substr(1, closeBracket - 1);
-                    msg.message = cleanLine.substr(closeBracket + 2);
-                }
-            }
-            // Format: PlayerName>> Message (Tell)
-            else
-            {
-                size_t tellMarker = cleanLine.find(">> ");
-                if (tellMarker != std::string::npos)
-                {
-                    msg.type = ChatMessageType::Tell;
-                    msg.sender = cleanLine.substr(0, tellMarker);
-                    msg.message = cleanLine.substr(tellMarker + 3);
-                }
-                else
-                {
-                    // Format: PlayerName : Message (Say/Shout)
-                    size_t colonMarker = cleanLine.find(" : ");
-                    if (colonMarker != std::string::npos)
-                    {
-                        msg.type = ChatMessageType::Say; // Default to Say, hard to distinguish Shout without color
-                        msg.sender = cleanLine.substr(0, colonMarker);
-                        msg.message = cleanLine.substr(colonMarker + 3);
-                    }
-                    else
-                    {
-                        // Fallback
-                        msg.sender = "Unknown";
-                        msg.message = cleanLine;
-                    }
-                }
-            }
+            // Shared parser; sender and message are slices of cleanLine
+            ChatMessageView msg = ChatParser::parse(cleanLine);
             
             std::cout << "[EliteAPI] DEBUG Parsed - Sender: " << msg.sender << ", Type: " << msg.getMessageTypeString() << ", Msg: " << msg.message << std::endl;
 
@@ -611,14 +554,11 @@ public:
                 // Store in recent messages
                 {
                     std::lock_guard<std::mutex> lock(chatMutex);
-                    recentMessages.push_back(msg);
-                    if (recentMessages.size() > 100)
-                    {
-                        recentMessages.pop_front();
-                    }
+                    recentMessages.append(msg);
+                    recentMessages.trimTo(RECENT_MESSAGE_LIMIT);
                 }
 
-                // Call callback if registered
+                // The callback (Player::onChatMessage) filters the line and batches it for the server
                 if (chatCallback)
                 {
                     try
@@ -630,46 +570,6 @@ public:
                         std::cout << "[EliteAPI] Exception in chat callback" << std::endl;
                     }
                 }
-
-                // Send to Server
-                try
-                {
-                    HttpClient client;
-
-                    // Simple JSON escaping
-                    auto escapeJson = [](const std::string& s) {
-                        std::string out;
-                        for (char c : s) {
-                            if (c == '"') out += "\\\"";
-                            else if (c == '\\') out += "\\\\";
-                            else if (c == '\b') out += "\\b";
-                            else if (c == '\f') out += "\\f";
-                            else if (c == '\n') out += "\\n";
-                            else if (c == '\r') out += "\\r";
-                            else if (c == '\t') out += "\\t";
-                            else out += c;
-                        }
-                        return out;
-                    };
-
-                    std::string json = "{";
-                    json += "\"sender\": \"" + escapeJson(msg.sender) + "\",";
-                    json += "\"message\": \"" + escapeJson(msg.message) + "\",";
-                    json += "\"type\": \"" + msg.getMessageTypeString() + "\",";
-                    json += "\"timestamp\": " + std::to_string(msg.timestamp);
-                    json += "}";
-
-                    std::cout << "[EliteAPI] DEBUG JSON Payload: " << json << std::endl;
-
-                    // Fire and forget - don't block too long
-                    client.setTimeout(2);
-                    auto response = client.post("http://192.168.5.30/chat", json);
-                    std::cout << "[EliteAPI] DEBUG HTTP Response Code: " << response.statusCode << std::endl;
-                }
-                catch (const std::exception& e)
-                {
-                    std::cout << "[EliteAPI] Failed to send chat to server: " << e.what() << std::endl;
-                }
             }
         }
         catch (const std::exception& e)
@@ -681,39 +581,6 @@ public:
             std::cout << "[EliteAPI] Unknown exception in ParseChatLine" << std::endl;
         }
     }
-
-    // Remove FFXI/Elite API formatting codes from text
-    std::string RemoveFormattingCodes(const std::string& text)
-    {
-        std::string result;
-        result.reserve(text.length());
-
-        for (size_t i = 0; i < text.length(); i++)
-        {
-            unsigned char c = static_cast<unsigned char>(text[i]);
-
-            // FFXI uses various escape codes (0x1E, 0x1F, 0x7F, etc.)
-            if (c == 0x1E || c == 0x1F || c == 0x7F)
-            {
-                // Skip the next few bytes (color codes, etc.)
-                if (c == 0x1F && i + 1 < text.length())
-                {
-                    i++; // Skip the parameter byte
-                }
-                continue;
-            }
-
-            // Skip control characters
-            if (c < 0x20 && c != '\n' && c != '\r' && c != '\t')
-            {
-                continue;
-            }
-
-            result += text[i];
-        }
-
-        return result;
-    }
 };
 
 // EliteAPI wrapper implementation
@@ -0,0 +1,379 @@
+#include "Player/EntityProperty.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+// Static definitions
+const std::string EntityProperty::API_ENDPOINT = "http://192.168.5.30:8080/set_nearby";
+const float EntityProperty::GRID_CELL_SIZE = 16.0f;
+const float EntityProperty::NEARBY_RADIUS = 50.0f;
+
+EntityProperty::EntityTable::EntityTable()
+	: pointers(MAX_ENTITIES, 0)
+	, serverIds(MAX_ENTITIES, 0)
+	, nameOffsets(MAX_ENTITIES, 0)
+	, x(MAX_ENTITIES, 0.0f)
+	, y(MAX_ENTITIES, 0.0f)
+	, z(MAX_ENTITIES, 0.0f)
+	, hpp(MAX_ENTITIES, 0)
+	, status(MAX_ENTITIES, 0)
+	, type(MAX_ENTITIES, 0)
+	, grid(GRID_CELL_SIZE, MAX_ENTITIES)
+{
+	namePool.push_back('\0'); // Offset 0 is the empty name
+}
+
+EntityProperty::EntityProperty()
+{
+}
+
+void EntityProperty::refresh(const PlayerProcessInfo &process)
+{
+	uintptr_t arrayAddress = FindDMAAddy(process.hProcess, process.dllBase + EntityLayout::ENTITY_ARRAY_OFFSET, EntityLayout::ENTITY_ARRAY_OFFSETS);
+	if (arrayAddress == 0)
+	{
+		return;
+	}
+
+	// One read for the whole pointer array
+	std::vector<uint32_t> pointers(MAX_ENTITIES, 0);
+	if (!ReadProcessMemory(process.hProcess, (BYTE *)arrayAddress, pointers.data(), pointers.size() * sizeof(uint32_t), nullptr))
+	{
+		std::cout << "Failed to read entity array for process " << process.procId << std::endl;
+		return;
+	}
+
+	// Entities come from a pool, so sorting by address lets neighbours share a read
+	std::vector<uint32_t> order;
+	order.reserve(MAX_ENTITIES);
+	for (uint32_t i = 0; i < MAX_ENTITIES; i++)
+	{
+		if (pointers[i] != 0)
+		{
+			order.push_back(i);
+		}
+	}
+	std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return pointers[a] < pointers[b]; });
+
+	EntityMask readMask;
+	EntityMask unreadMask;  // Slots whose memory couldn't be read this tick; they keep their last state
+	std::vector<uint8_t> rawEntities(order.size() * EntityLayout::READ_SIZE);
+	std::vector<uint8_t> batch;
+
+	size_t start = 0;
+	while (start < order.size())
+	{
+		// Grow the range while the next entity is close and the batch stays bounded
+		uint32_t rangeBegin = pointers[order[start]];
+		uint32_t rangeEnd = rangeBegin + EntityLayout::READ_SIZE;
+		size_t end = start + 1;
+		while (end < order.size())
+		{
+			uint32_t next = pointers[order[end]];
+			if (next > rangeEnd + MAX_GAP_BYTES || next + EntityLayout::READ_SIZE - rangeBegin > MAX_BATCH_BYTES)
+			{
+				break;
+			}
+			rangeEnd = std::max(rangeEnd, next + EntityLayout::READ_SIZE);
+			end++;
+		}
+
+		batch.resize(rangeEnd - rangeBegin);
+		if (ReadProcessMemory(process.hProcess, (BYTE *)(uintptr_t)rangeBegin, batch.data(), batch.size(), nullptr))
+		{
+			for (size_t i = start; i < end; i++)
+			{
+				std::memcpy(&rawEntities[i * EntityLayout::READ_SIZE], &batch[pointers[order[i]] - rangeBegin], EntityLayout::READ_SIZE);
+				readMask.set(order[i]);
+			}
+		}
+		else
+		{
+			// One bad page shouldn't despawn every neighbour in the range - retry them one at a time
+			for (size_t i = start; i < end; i++)
+			{
+				if (ReadProcessMemory(process.hProcess, (BYTE *)(uintptr_t)pointers[order[i]], &rawEntities[i * EntityLayout::READ_SIZE], EntityLayout::READ_SIZE, nullptr))
+				{
+					readMask.set(order[i]);
+				}
+				else
+				{
+					unreadMask.set(order[i]);
+				}
+			}
+		}
+
+		start = end;
+	}
+
+	DWORD selfId = g_playerInstance ? g_playerInstance->getPlayerId(process.procId) : 0;
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	EntityTable &table = tables[process.procId];
+	table.pointers.swap(pointers);
+	table.selfIndex = -1;
+
+	// Slots that disappeared (an unreadable slot is still occupied)
+	EntityMask occupied;
+	EntityMask despawned;
+	EntityMask::orOf(readMask, unreadMask, occupied);
+	EntityMask::andNotOf(table.valid, occupied, despawned);
+	despawned.forEachSetBit([&](size_t index) {
+		table.grid.remove(static_cast<uint32_t>(index));
+		table.serverIds[index] = 0;
+		table.nameOffsets[index] = 0;
+	});
+
+	// Unreadable slots stay valid only if they were before
+	EntityMask kept;
+	EntityMask::andOf(table.valid, unreadMask, kept);
+	EntityMask::orOf(readMask, kept, table.valid);
+
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		uint32_t index = order[i];
+		if (!readMask.test(index))
+		{
+			if (table.valid.test(index) && selfId != 0 && table.serverIds[index] == selfId)
+			{
+				table.selfIndex = static_cast<int>(index);
+			}
+			continue;
+		}
+
+		const uint8_t *raw = &rawEntities[i * EntityLayout::READ_SIZE];
+		uint32_t serverId;
+		float posX, posY, posZ;
+		std::memcpy(&serverId, raw + EntityLayout::SERVER_ID, sizeof(serverId));
+		std::memcpy(&posX, raw + EntityLayout::POS_X, sizeof(posX));
+		std::memcpy(&posY, raw + EntityLayout::POS_Y, sizeof(posY));
+		std::memcpy(&posZ, raw + EntityLayout::POS_Z, sizeof(posZ));
+
+		// New occupant of the slot - intern its name
+		if (serverId != table.serverIds[index] || table.nameOffsets[index] == 0)
+		{
+			const char *name = reinterpret_cast<const char *>(raw + EntityLayout::NAME);
+			size_t nameLength = strnlen(name, EntityLayout::NAME_LENGTH);
+			table.nameOffsets[index] = static_cast<uint32_t>(table.namePool.size());
+			table.namePool.insert(table.namePool.end(), name, name + nameLength);
+			table.namePool.push_back('\0');
+			table.serverIds[index] = serverId;
+		}
+
+		table.hpp[index] = raw[EntityLayout::HPP];
+		table.status[index] = raw[EntityLayout::STATUS];
+		table.type[index] = raw[EntityLayout::TYPE];
+		table.z[index] = posZ;
+
+		// Only touch the grid for entities that moved
+		if (!table.grid.contains(index) || table.x[index] != posX || table.y[index] != posY)
+		{
+			table.x[index] = posX;
+			table.y[index] = posY;
+			table.grid.update(index, posX, posY);
+		}
+
+		if (selfId != 0 && serverId == selfId)
+		{
+			table.selfIndex = static_cast<int>(index);
+		}
+	}
+
+	compactNames(table);
+
+	// Recompute the nearby set
+	std::vector<uint32_t> nearby;
+	if (table.selfIndex >= 0)
+	{
+		for (uint32_t index : table.grid.queryRadius(table.x[table.selfIndex], table.y[table.selfIndex], NEARBY_RADIUS))
+		{
+			if (static_cast<int>(index) != table.selfIndex)
+			{
+				nearby.push_back(table.serverIds[index]);
+			}
+		}
+		std::sort(nearby.begin(), nearby.end());
+	}
+
+	if (nearby != table.nearby)
+	{
+		table.nearby.swap(nearby);
+		bumpVersion(process.procId);
+	}
+}
+
+void EntityProperty::compactNames(EntityTable &table) const
+{
+	// Names are append-only; rebuild once the pool is mostly dead entries
+	const size_t liveEstimate = table.valid.count() * (EntityLayout::NAME_LENGTH / 2) + 1;
+	if (table.namePool.size() < 4 * liveEstimate || table.namePool.size() < 0x4000)
+	{
+		return;
+	}
+
+	std::vector<char> pool;
+	pool.reserve(liveEstimate * 2);
+	pool.push_back('\0');
+	table.valid.forEachSetBit([&](size_t index) {
+		const char *name = &table.namePool[table.nameOffsets[index]];
+		table.nameOffsets[index] = static_cast<uint32_t>(pool.size());
+		pool.insert(pool.end(), name, name + std::strlen(name) + 1);
+	});
+	table.namePool.swap(pool);
+}
+
+EntityProperty::EntityInfo EntityProperty::makeInfo(const EntityTable &table, uint32_t index, float originX, float originY) const
+{
+	EntityInfo info;
+	info.index = static_cast<uint16_t>(index);
+	info.serverId = table.serverIds[index];
+	info.name = &table.namePool[table.nameOffsets[index]];
+	info.x = table.x[index];
+	info.y = table.y[index];
+	info.z = table.z[index];
+	info.hpp = table.hpp[index];
+	info.status = table.status[index];
+	info.type = table.type[index];
+	float dx = info.x - originX;
+	float dy = info.y - originY;
+	info.distance = std::sqrt(dx * dx + dy * dy);
+	return info;
+}
+
+std::vector<EntityProperty::EntityInfo> EntityProperty::getNearby(DWORD procId, float radius, uint32_t typeMask) const
+{
+	std::vector<EntityInfo> result;
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = tables.find(procId);
+	if (it == tables.end() || it->second.selfIndex < 0)
+	{
+		return result;
+	}
+
+	const EntityTable &table = it->second;
+	float originX = table.x[table.selfIndex];
+	float originY = table.y[table.selfIndex];
+	for (uint32_t index : table.grid.queryRadius(originX, originY, radius))
+	{
+		if (static_cast<int>(index) == table.selfIndex || table.type[index] >= 32 || !(typeMask & (1u << table.type[index])))
+		{
+			continue;
+		}
+		result.push_back(makeInfo(table, index, originX, originY));
+	}
+
+	std::sort(result.begin(), result.end(), [](const EntityInfo &a, const EntityInfo &b) { return a.distance < b.distance; });
+	return result;
+}
+
+std::vector<EntityProperty::EntityInfo> EntityProperty::getNearest(DWORD procId, size_t k) const
+{
+	std::vector<EntityInfo> result;
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = tables.find(procId);
+	if (it == tables.end() || it->second.selfIndex < 0)
+	{
+		return result;
+	}
+
+	const EntityTable &table = it->second;
+	float originX = table.x[table.selfIndex];
+	float originY = table.y[table.selfIndex];
+	for (uint32_t index : table.grid.queryNearest(originX, originY, k, static_cast<uint32_t>(table.selfIndex)))
+	{
+		result.push_back(makeInfo(table, index, originX, originY));
+	}
+	return result;
+}
+
+size_t EntityProperty::getEntityCount(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = tables.find(procId);
+	return (it != tables.end()) ? it->second.valid.count() : 0;
+}
+
+const char *EntityProperty::getPropertyName() const
+{
+	return "Entities";
+}
+
+void EntityProperty::displayValue(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = tables.find(procId);
+	if (it == tables.end())
+	{
+		std::cout << "Unknown";
+		return;
+	}
+	std::cout << it->second.valid.count() << " loaded, " << it->second.nearby.size() << " nearby";
+}
+
+long long EntityProperty::getNumericValue(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = tables.find(procId);
+	return (it != tables.end()) ? static_cast<long long>(it->second.nearby.size()) : 0;
+}
+
+bool EntityProperty::hasChanged(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = tables.find(procId);
+	return it != tables.end() && it->second.nearby != it->second.reportedNearby;
+}
+
+void EntityProperty::acknowledgeChange(DWORD procId)
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = tables.find(procId);
+	if (it != tables.end())
+	{
+		it->second.reportedNearby = it->second.nearby;
+	}
+}
+
+void EntityProperty::onIdentityChanged(DWORD procId)
+{
+	PlayerProperty::onIdentityChanged(procId);
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	tables.erase(procId);
+}
+
+void EntityProperty::reportChange(DWORD procId) const
+{
+	if (!g_playerInstance)
+	{
+		return;
+	}
+
+	std::vector<EntityInfo> nearby = getNearby(procId, NEARBY_RADIUS);
+
+	std::ostringstream jsonPayload;
+	jsonPayload << "{"
+	           << "\"playerName\":\"" << escapeJsonString(g_playerInstance->getPlayerName(procId)) << "\","
+	           << "\"playerId\":" << g_playerInstance->getPlayerId(procId) << ","
+	           << "\"nearby\":[";
+
+	for (size_t i = 0; i < nearby.size(); i++)
+	{
+		const EntityInfo &entity = nearby[i];
+		jsonPayload << (i > 0 ? "," : "") << "{"
+		           << "\"index\":" << entity.index << ","
+		           << "\"id\":" << entity.serverId << ","
+		           << "\"name\":\"" << escapeJsonString(entity.name) << "\","
+		           << "\"type\":" << static_cast<int>(entity.type) << ","
+		           << "\"status\":" << static_cast<int>(entity.status) << ","
+		           << "\"hpp\":" << static_cast<int>(entity.hpp) << ","
+		           << "\"distance\":" << entity.distance << "}";
+	}
+	jsonPayload << "]}";
+
+	g_playerInstance->getChangePublisher().publish(procId, getPropertyName(), API_ENDPOINT, jsonPayload.str());
+}
@@ -0,0 +1,191 @@
+#include "Player/EnvironmentProperty.h"
+#include "helpers/vanaclock.h"
+#include <iostream>
+#include <sstream>
+
+// Static API endpoint definition
+const std::string EnvironmentProperty::API_ENDPOINT = "http://192.168.5.30:8080/set_environment";
+
+EnvironmentProperty::EnvironmentProperty()
+{
+}
+
+bool EnvironmentProperty::readWeather(const PlayerProcessInfo &process, int &weather) const
+{
+	uintptr_t weatherAddress = FindDMAAddy(process.hProcess, process.dllBase + weatherBaseOffset, weatherOffsets);
+	if (weatherAddress == 0)
+	{
+		return false;
+	}
+
+	uint8_t raw = 0;
+	if (!ReadProcessMemory(process.hProcess, (BYTE *)weatherAddress, &raw, sizeof(raw), nullptr))
+	{
+		return false;
+	}
+
+	weather = raw;
+	return true;
+}
+
+void EnvironmentProperty::refresh(const PlayerProcessInfo &process)
+{
+	uintptr_t zoneAddress = FindDMAAddy(process.hProcess, process.dllBase + zoneBaseOffset, zoneOffsets);
+	if (zoneAddress == 0)
+	{
+		return;
+	}
+
+	uint16_t zone = 0;
+	if (!ReadProcessMemory(process.hProcess, (BYTE *)zoneAddress, &zone, sizeof(zone), nullptr) || zone == 0)
+	{
+		return; // Zoning
+	}
+
+	auto now = std::chrono::steady_clock::now();
+	const auto weatherLifetime = std::chrono::milliseconds(static_cast<long long>(VanaClock::EARTH_SECONDS_PER_VANA_HOUR * 1000));
+
+	{
+		std::lock_guard<std::mutex> lock(propertyMutex);
+		EnvironmentState &state = states[process.procId];
+		auto cached = weatherByZone.find(zone);
+		bool cacheValid = cached != weatherByZone.end() && now - cached->second.readAt < weatherLifetime;
+
+		if (cacheValid)
+		{
+			// Another character in this zone (or an earlier tick) already paid for the read
+			if (state.zone != zone || state.weather != cached->second.weather)
+			{
+				state.zone = zone;
+				state.weather = cached->second.weather;
+				bumpVersion(process.procId);
+			}
+			return;
+		}
+	}
+
+	// New zone for this character, or the zone's cached weather has expired
+	int weather = -1;
+	if (!readWeather(process, weather))
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	weatherReads++;
+	WeatherEntry &entry = weatherByZone[zone];
+	entry.weather = weather;
+	entry.readAt = now;
+
+	EnvironmentState &state = states[process.procId];
+	if (state.zone != zone || state.weather != weather)
+	{
+		state.zone = zone;
+		state.weather = weather;
+		bumpVersion(process.procId);
+	}
+}
+
+const char *EnvironmentProperty::getPropertyName() const
+{
+	return "Environment";
+}
+
+void EnvironmentProperty::displayValue(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	if (it == states.end())
+	{
+		std::cout << "Unknown";
+		return;
+	}
+	std::cout << "zone " << it->second.zone << ", weather " << it->second.weather;
+}
+
+long long EnvironmentProperty::getNumericValue(DWORD procId) const
+{
+	return getZone(procId);
+}
+
+uint16_t EnvironmentProperty::getZone(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	return (it != states.end()) ? it->second.zone : 0;
+}
+
+int EnvironmentProperty::getWeather(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	return (it != states.end()) ? it->second.weather : -1;
+}
+
+uint64_t EnvironmentProperty::getWeatherReadCount() const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	return weatherReads;
+}
+
+bool EnvironmentProperty::hasChanged(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	return it != states.end() &&
+	       (it->second.zone != it->second.reportedZone || it->second.weather != it->second.reportedWeather);
+}
+
+void EnvironmentProperty::acknowledgeChange(DWORD procId)
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	if (it != states.end())
+	{
+		it->second.reportedZone = it->second.zone;
+		it->second.reportedWeather = it->second.weather;
+	}
+}
+
+void EnvironmentProperty::onIdentityChanged(DWORD procId)
+{
+	PlayerProperty::onIdentityChanged(procId);
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	states.erase(procId);
+}
+
+void EnvironmentProperty::reportChange(DWORD procId) const
+{
+	if (!g_playerInstance)
+	{
+		return;
+	}
+
+	uint16_t zone = getZone(procId);
+	int weather = getWeather(procId);
+	VanaClock::VanaTime vanaTime = g_playerInstance->getVanaClock().now();
+
+	std::ostringstream jsonPayload;
+	jsonPayload << "{"
+	           << "\"playerName\":\"" << escapeJsonString(g_playerInstance->getPlayerName(procId)) << "\","
+	           << "\"playerId\":" << g_playerInstance->getPlayerId(procId) << ","
+	           << "\"zone\":" << zone << ",";
+
+	std::string_view zoneName = g_playerInstance->getResources().nameOf(ResourceTables::Kind::Zones, zone);
+	if (!zoneName.empty())
+	{
+		jsonPayload << "\"zoneName\":\"" << escapeJsonString(std::string(zoneName)) << "\",";
+	}
+
+	jsonPayload << "\"weather\":" << weather << ","
+	           << "\"vanaTime\":{"
+	           << "\"day\":" << vanaTime.day << ","
+	           << "\"hour\":" << vanaTime.hour << ","
+	           << "\"minute\":" << vanaTime.minute << ","
+	           << "\"weekday\":\"" << VanaClock::weekdayName(vanaTime.weekday) << "\","
+	           << "\"moonPercent\":" << vanaTime.moonPercent << "}"
+	           << "}";
+
+	g_playerInstance->getChangePublisher().publish(procId, getPropertyName(), API_ENDPOINT, jsonPayload.str());
+}
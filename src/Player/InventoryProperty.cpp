@@ -0,0 +1,375 @@
+#include "Player/InventoryProperty.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+// Static API endpoint definition
+const std::string InventoryProperty::API_ENDPOINT = "http://192.168.5.30:8080/set_inventory";
+
+InventoryProperty::InventoryProperty()
+{
+}
+
+const char *InventoryProperty::getContainerName(Container container)
+{
+	switch (container)
+	{
+		case Container::Inventory: return "inventory";
+		case Container::Safe: return "safe";
+		case Container::Storage: return "storage";
+		case Container::Temporary: return "temporary";
+		case Container::Locker: return "locker";
+		case Container::Satchel: return "satchel";
+		case Container::Sack: return "sack";
+		case Container::Case: return "case";
+		case Container::Wardrobe: return "wardrobe";
+		case Container::Safe2: return "safe2";
+		case Container::Wardrobe2: return "wardrobe2";
+		case Container::Wardrobe3: return "wardrobe3";
+		case Container::Wardrobe4: return "wardrobe4";
+		default: return "unknown";
+	}
+}
+
+void InventoryProperty::indexAdd(DWORD characterId, uint8_t container, uint8_t slot, uint16_t itemId, uint32_t count)
+{
+	ItemLocation location;
+	location.characterId = characterId;
+	location.container = container;
+	location.slot = slot;
+	location.count = count;
+	itemIndex[itemId].push_back(location);
+}
+
+void InventoryProperty::indexRemove(DWORD characterId, uint8_t container, uint8_t slot, uint16_t itemId)
+{
+	auto it = itemIndex.find(itemId);
+	if (it == itemIndex.end())
+	{
+		return;
+	}
+
+	std::vector<ItemLocation> &locations = it->second;
+	for (size_t i = 0; i < locations.size(); i++)
+	{
+		const ItemLocation &location = locations[i];
+		if (location.characterId == characterId && location.container == container && location.slot == slot)
+		{
+			locations[i] = locations.back();
+			locations.pop_back();
+			break;
+		}
+	}
+
+	if (locations.empty())
+	{
+		itemIndex.erase(it);
+	}
+}
+
+void InventoryProperty::refresh(const PlayerProcessInfo &process)
+{
+	DWORD characterId = g_playerInstance ? g_playerInstance->getPlayerId(process.procId) : 0;
+	if (characterId == 0)
+	{
+		return;
+	}
+
+	uintptr_t baseAddress = FindDMAAddy(process.hProcess, process.dllBase + containerBaseOffset, containerOffsets);
+	if (baseAddress == 0)
+	{
+		return;
+	}
+
+	// One range read per container; the slot columns we keep are extracted afterwards
+	std::array<ContainerSnapshot, CONTAINER_COUNT> fresh{};
+	std::array<bool, CONTAINER_COUNT> readOk{};
+	RawItem raw[SLOTS_PER_CONTAINER];
+	for (size_t c = 0; c < CONTAINER_COUNT; c++)
+	{
+		uintptr_t containerAddress = baseAddress + c * CONTAINER_STRIDE;
+		if (!ReadProcessMemory(process.hProcess, (BYTE *)containerAddress, raw, sizeof(raw), nullptr))
+		{
+			continue;
+		}
+
+		readOk[c] = true;
+		for (size_t s = 0; s < SLOTS_PER_CONTAINER; s++)
+		{
+			fresh[c][s].itemId = raw[s].id;
+			fresh[c][s].count = raw[s].id ? raw[s].count : 0;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	// A process that just (re)appeared gets a full snapshot even if the character was indexed before
+	bool newSession = processCharacters.find(process.procId) == processCharacters.end();
+	processCharacters[process.procId] = characterId;
+	CharacterInventory &inventory = characters[characterId];
+	std::vector<SlotChange> &changes = pendingChanges[process.procId];
+	bool firstPass = !inventory.loaded || newSession;
+
+	for (size_t c = 0; c < CONTAINER_COUNT; c++)
+	{
+		if (!readOk[c])
+		{
+			continue; // Keep the last known contents rather than treating the container as emptied
+		}
+
+		for (size_t s = 0; s < SLOTS_PER_CONTAINER; s++)
+		{
+			SlotState &previous = inventory.containers[c][s];
+			const SlotState &current = fresh[c][s];
+			if (previous.itemId == current.itemId && previous.count == current.count)
+			{
+				continue;
+			}
+
+			uint8_t container = static_cast<uint8_t>(c);
+			uint8_t slot = static_cast<uint8_t>(s);
+			if (previous.itemId != 0)
+			{
+				indexRemove(characterId, container, slot, previous.itemId);
+			}
+			if (current.itemId != 0)
+			{
+				indexAdd(characterId, container, slot, current.itemId, current.count);
+			}
+			previous = current;
+
+			if (!firstPass)
+			{
+				SlotChange change;
+				change.container = container;
+				change.slot = slot;
+				change.itemId = current.itemId;
+				change.count = current.count;
+				changes.push_back(change);
+			}
+		}
+	}
+
+	if (firstPass)
+	{
+		// First pass is reported as a full snapshot, not as thousands of slot changes
+		inventory.loaded = true;
+		pendingFullSnapshot[process.procId] = true;
+		bumpVersion(process.procId);
+	}
+	else if (!changes.empty())
+	{
+		bumpVersion(process.procId);
+	}
+}
+
+const char *InventoryProperty::getPropertyName() const
+{
+	return "Inventory";
+}
+
+void InventoryProperty::displayValue(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto characterIt = processCharacters.find(procId);
+	if (characterIt == processCharacters.end())
+	{
+		std::cout << "Unknown";
+		return;
+	}
+
+	auto inventoryIt = characters.find(characterIt->second);
+	if (inventoryIt == characters.end())
+	{
+		std::cout << "Unknown";
+		return;
+	}
+
+	size_t used = 0;
+	for (const ContainerSnapshot &container : inventoryIt->second.containers)
+	{
+		used += std::count_if(container.begin(), container.end(), [](const SlotState &slot) { return slot.itemId != 0; });
+	}
+	std::cout << used << " items across " << CONTAINER_COUNT << " containers";
+}
+
+std::vector<InventoryProperty::ItemLocation> InventoryProperty::findItem(uint16_t itemId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = itemIndex.find(itemId);
+	return (it != itemIndex.end()) ? it->second : std::vector<ItemLocation>();
+}
+
+uint64_t InventoryProperty::totalCount(uint16_t itemId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = itemIndex.find(itemId);
+	if (it == itemIndex.end())
+	{
+		return 0;
+	}
+
+	uint64_t total = 0;
+	for (const ItemLocation &location : it->second)
+	{
+		total += location.count;
+	}
+	return total;
+}
+
+uint64_t InventoryProperty::countFor(DWORD characterId, uint16_t itemId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = itemIndex.find(itemId);
+	if (it == itemIndex.end())
+	{
+		return 0;
+	}
+
+	uint64_t total = 0;
+	for (const ItemLocation &location : it->second)
+	{
+		if (location.characterId == characterId)
+		{
+			total += location.count;
+		}
+	}
+	return total;
+}
+
+std::vector<DWORD> InventoryProperty::whoHas(uint16_t itemId) const
+{
+	std::vector<DWORD> owners;
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = itemIndex.find(itemId);
+	if (it == itemIndex.end())
+	{
+		return owners;
+	}
+
+	for (const ItemLocation &location : it->second)
+	{
+		if (std::find(owners.begin(), owners.end(), location.characterId) == owners.end())
+		{
+			owners.push_back(location.characterId);
+		}
+	}
+	return owners;
+}
+
+bool InventoryProperty::hasChanged(DWORD procId) const
+{
+	// A snapshot or diff that never arrived is repaired with a full snapshot
+	bool lost = g_playerInstance && g_playerInstance->getChangePublisher().isLost(procId, getPropertyName());
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	if (lost && processCharacters.find(procId) != processCharacters.end())
+	{
+		return true;
+	}
+
+	auto fullIt = pendingFullSnapshot.find(procId);
+	if (fullIt != pendingFullSnapshot.end() && fullIt->second)
+	{
+		return true;
+	}
+
+	auto changesIt = pendingChanges.find(procId);
+	return changesIt != pendingChanges.end() && !changesIt->second.empty();
+}
+
+void InventoryProperty::acknowledgeChange(DWORD procId)
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	pendingChanges[procId].clear();
+	pendingFullSnapshot[procId] = false;
+}
+
+void InventoryProperty::onIdentityChanged(DWORD procId)
+{
+	PlayerProperty::onIdentityChanged(procId);
+
+	// The old character's contents stay indexed; only the process mapping is dropped
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	processCharacters.erase(procId);
+	pendingChanges.erase(procId);
+	pendingFullSnapshot.erase(procId);
+}
+
+void InventoryProperty::reportChange(DWORD procId) const
+{
+	if (!g_playerInstance)
+	{
+		return;
+	}
+
+	// The receiver lost a snapshot or diff, so its copy can't be patched any more
+	bool lost = g_playerInstance->getChangePublisher().takeLost(procId, getPropertyName());
+
+	std::ostringstream jsonPayload;
+	jsonPayload << "{"
+	           << "\"playerName\":\"" << escapeJsonString(g_playerInstance->getPlayerName(procId)) << "\","
+	           << "\"playerId\":" << g_playerInstance->getPlayerId(procId) << ",";
+
+	{
+		std::lock_guard<std::mutex> lock(propertyMutex);
+		auto characterIt = processCharacters.find(procId);
+		if (characterIt == processCharacters.end())
+		{
+			return;
+		}
+
+		auto fullIt = pendingFullSnapshot.find(procId);
+		bool full = lost || (fullIt != pendingFullSnapshot.end() && fullIt->second);
+		jsonPayload << "\"full\":" << (full ? "true" : "false") << ",\"slots\":[";
+
+		const ResourceTables &resources = g_playerInstance->getResources();
+		bool first = true;
+		auto writeSlot = [&](size_t container, size_t slot, uint16_t itemId, uint32_t count) {
+			jsonPayload << (first ? "" : ",") << "{"
+			           << "\"container\":\"" << getContainerName(static_cast<Container>(container)) << "\","
+			           << "\"slot\":" << slot << ","
+			           << "\"item\":" << itemId << ","
+			           << "\"count\":" << count;
+			std::string_view itemName = resources.nameOf(ResourceTables::Kind::Items, itemId);
+			if (!itemName.empty())
+			{
+				jsonPayload << ",\"name\":\"" << escapeJsonString(std::string(itemName)) << "\"";
+			}
+			jsonPayload << "}";
+			first = false;
+		};
+
+		if (full)
+		{
+			const CharacterInventory &inventory = characters.at(characterIt->second);
+			for (size_t c = 0; c < CONTAINER_COUNT; c++)
+			{
+				for (size_t s = 0; s < SLOTS_PER_CONTAINER; s++)
+				{
+					const SlotState &state = inventory.containers[c][s];
+					if (state.itemId != 0)
+					{
+						writeSlot(c, s, state.itemId, state.count);
+					}
+				}
+			}
+		}
+		else
+		{
+			auto changesIt = pendingChanges.find(procId);
+			if (changesIt != pendingChanges.end())
+			{
+				for (const SlotChange &change : changesIt->second)
+				{
+					writeSlot(change.container, change.slot, change.itemId, change.count);
+				}
+			}
+		}
+		jsonPayload << "]";
+	}
+	jsonPayload << "}";
+
+	// Each report is a diff, so it gets its own publisher slot instead of letting a newer diff replace it
+	g_playerInstance->getChangePublisher().publishOrdered(procId, getPropertyName(), API_ENDPOINT, jsonPayload.str());
+}
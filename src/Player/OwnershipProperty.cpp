@@ -0,0 +1,290 @@
+#include "Player/OwnershipProperty.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+// Static API endpoint definition
+const std::string OwnershipProperty::API_ENDPOINT = "http://192.168.5.30:8080/set_ownership";
+
+// Ownership table locations (pointer base, offsets, packed size in bytes)
+const OwnershipProperty::TableLayout OwnershipProperty::TABLE_LAYOUTS[CATEGORY_COUNT] = {
+	{0x004AD0C0, {0x00}, 512},  // Key items
+	{0x004AD2C0, {0x00}, 128},  // Spells
+	{0x004AD340, {0x00}, 128},  // Abilities
+	{0x004AD3C0, {0x00}, 32},   // Traits
+	{0x004AD3E0, {0x00}, 32},   // Weapon skills
+};
+
+OwnershipProperty::OwnershipProperty()
+{
+}
+
+const char *OwnershipProperty::getCategoryName(Category category)
+{
+	switch (category)
+	{
+		case Category::KeyItems: return "keyItems";
+		case Category::Spells: return "spells";
+		case Category::Abilities: return "abilities";
+		case Category::Traits: return "traits";
+		case Category::WeaponSkills: return "weaponSkills";
+		default: return "unknown";
+	}
+}
+
+void OwnershipProperty::refresh(const PlayerProcessInfo &process)
+{
+	OwnershipSet sets[CATEGORY_COUNT];
+
+	for (size_t i = 0; i < CATEGORY_COUNT; i++)
+	{
+		const TableLayout &layout = TABLE_LAYOUTS[i];
+		uintptr_t tableAddress = FindDMAAddy(process.hProcess, process.dllBase + layout.baseOffset, layout.offsets);
+		if (tableAddress == 0)
+		{
+			return;
+		}
+
+		// One range read per table, straight into the bitset words (x86 is little-endian)
+		size_t byteSize = std::min(layout.byteSize, MAX_OWNERSHIP_ID / 8);
+		if (!ReadProcessMemory(process.hProcess, (BYTE *)tableAddress, sets[i].data(), byteSize, nullptr))
+		{
+			std::cout << "Failed to read " << getCategoryName(static_cast<Category>(i))
+			          << " ownership for process " << process.procId << std::endl;
+			return;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	OwnershipState &state = states[process.procId];
+
+	bool changed = false;
+	for (size_t i = 0; i < CATEGORY_COUNT; i++)
+	{
+		if (state.current[i] != sets[i])
+		{
+			state.current[i] = sets[i];
+			changed = true;
+		}
+	}
+
+	if (!state.loaded)
+	{
+		// First pass is the baseline - don't report everything as newly obtained
+		for (size_t i = 0; i < CATEGORY_COUNT; i++)
+		{
+			state.reported[i] = state.current[i];
+		}
+		state.loaded = true;
+	}
+
+	if (changed)
+	{
+		bumpVersion(process.procId);
+	}
+}
+
+const char *OwnershipProperty::getPropertyName() const
+{
+	return "Ownership";
+}
+
+void OwnershipProperty::displayValue(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	for (size_t i = 0; i < CATEGORY_COUNT; i++)
+	{
+		size_t owned = (it != states.end()) ? it->second.current[i].count() : 0;
+		std::cout << (i > 0 ? ", " : "") << getCategoryName(static_cast<Category>(i)) << "=" << owned;
+	}
+}
+
+bool OwnershipProperty::has(DWORD procId, Category category, uint16_t id) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	return it != states.end() && it->second.current[static_cast<size_t>(category)].test(id);
+}
+
+OwnershipProperty::OwnershipSet OwnershipProperty::getSet(DWORD procId, Category category) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	return (it != states.end()) ? it->second.current[static_cast<size_t>(category)] : OwnershipSet();
+}
+
+std::vector<DWORD> OwnershipProperty::whoHas(Category category, uint16_t id) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	std::vector<DWORD> owners;
+	for (const auto &pair : states)
+	{
+		if (pair.second.current[static_cast<size_t>(category)].test(id))
+		{
+			owners.push_back(pair.first);
+		}
+	}
+	return owners;
+}
+
+OwnershipProperty::OwnershipSet OwnershipProperty::ownedByAll(Category category) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	OwnershipSet result;
+	bool first = true;
+	for (const auto &pair : states)
+	{
+		const OwnershipSet &set = pair.second.current[static_cast<size_t>(category)];
+		if (first)
+		{
+			result = set;
+			first = false;
+		}
+		else
+		{
+			OwnershipSet::andOf(result, set, result);
+		}
+	}
+	return result;
+}
+
+OwnershipProperty::OwnershipSet OwnershipProperty::ownedByAny(Category category) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	OwnershipSet result;
+	for (const auto &pair : states)
+	{
+		OwnershipSet::orOf(result, pair.second.current[static_cast<size_t>(category)], result);
+	}
+	return result;
+}
+
+OwnershipProperty::OwnershipSet OwnershipProperty::missingFrom(DWORD procId, Category category) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	OwnershipSet others;
+	OwnershipSet mine;
+	for (const auto &pair : states)
+	{
+		const OwnershipSet &set = pair.second.current[static_cast<size_t>(category)];
+		if (pair.first == procId)
+			mine = set;
+		else
+			OwnershipSet::orOf(others, set, others);
+	}
+
+	OwnershipSet result;
+	OwnershipSet::andNotOf(others, mine, result);
+	return result;
+}
+
+bool OwnershipProperty::hasChanged(DWORD procId) const
+{
+	// A diff that never arrived is repaired by resending the full sets
+	bool lost = g_playerInstance && g_playerInstance->getChangePublisher().isLost(procId, getPropertyName());
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	if (it == states.end())
+	{
+		return false;
+	}
+	if (lost)
+	{
+		return true;
+	}
+
+	for (size_t i = 0; i < CATEGORY_COUNT; i++)
+	{
+		if (it->second.current[i] != it->second.reported[i])
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void OwnershipProperty::acknowledgeChange(DWORD procId)
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	if (it != states.end())
+	{
+		for (size_t i = 0; i < CATEGORY_COUNT; i++)
+		{
+			it->second.reported[i] = it->second.current[i];
+		}
+	}
+}
+
+void OwnershipProperty::onIdentityChanged(DWORD procId)
+{
+	PlayerProperty::onIdentityChanged(procId);
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	states.erase(procId);
+}
+
+void OwnershipProperty::reportChange(DWORD procId) const
+{
+	if (!g_playerInstance)
+	{
+		return;
+	}
+
+	// After a dropped or failed diff the receiver's sets are unknown, so this report carries them whole
+	bool full = g_playerInstance->getChangePublisher().takeLost(procId, getPropertyName());
+
+	std::ostringstream jsonPayload;
+	jsonPayload << "{"
+	           << "\"playerName\":\"" << escapeJsonString(g_playerInstance->getPlayerName(procId)) << "\","
+	           << "\"playerId\":" << g_playerInstance->getPlayerId(procId) << ","
+	           << "\"full\":" << (full ? "true" : "false");
+
+	auto writeIds = [&jsonPayload](const OwnershipSet &set) {
+		jsonPayload << "[";
+		bool first = true;
+		set.forEachSetBit([&](size_t id) {
+			jsonPayload << (first ? "" : ",") << id;
+			first = false;
+		});
+		jsonPayload << "]";
+	};
+
+	{
+		std::lock_guard<std::mutex> lock(propertyMutex);
+		auto it = states.find(procId);
+		if (it == states.end())
+		{
+			return;
+		}
+
+		for (size_t i = 0; i < CATEGORY_COUNT; i++)
+		{
+			OwnershipSet gained;
+			OwnershipSet lost;
+			OwnershipSet::andNotOf(it->second.current[i], it->second.reported[i], gained);
+			OwnershipSet::andNotOf(it->second.reported[i], it->second.current[i], lost);
+			if (!full && !gained.any() && !lost.any())
+			{
+				continue;
+			}
+
+			jsonPayload << ",\"" << getCategoryName(static_cast<Category>(i)) << "\":{\"gained\":";
+			writeIds(gained);
+			jsonPayload << ",\"lost\":";
+			writeIds(lost);
+			if (full)
+			{
+				jsonPayload << ",\"owned\":";
+				writeIds(it->second.current[i]);
+			}
+			jsonPayload << "}";
+		}
+	}
+	jsonPayload << "}";
+
+	// Each report is a diff, so it gets its own publisher slot instead of letting a newer diff replace it
+	g_playerInstance->getChangePublisher().publishOrdered(procId, getPropertyName(), API_ENDPOINT, jsonPayload.str());
+}
@@ -0,0 +1,417 @@
+#include "Player/PartyProperty.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <iostream>
+#include <sstream>
+
+// Static API endpoint definition
+const std::string PartyProperty::API_ENDPOINT = "http://192.168.5.30:8080/set_party";
+
+bool PartyProperty::PartyKey::operator<(const PartyKey &other) const
+{
+	if (allianceLeaderId != other.allianceLeaderId)
+		return allianceLeaderId < other.allianceLeaderId;
+	return std::lexicographical_compare(partyLeaderIds, partyLeaderIds + 3, other.partyLeaderIds, other.partyLeaderIds + 3);
+}
+
+bool PartyProperty::PartyKey::operator==(const PartyKey &other) const
+{
+	return allianceLeaderId == other.allianceLeaderId && std::equal(partyLeaderIds, partyLeaderIds + 3, other.partyLeaderIds);
+}
+
+PartyProperty::PartyProperty()
+{
+}
+
+bool PartyProperty::readPartyKey(const PlayerProcessInfo &process, PartyKey &key) const
+{
+	uintptr_t headerAddress = FindDMAAddy(process.hProcess, process.dllBase + allianceBaseOffset, allianceOffsets);
+	if (headerAddress == 0)
+	{
+		return false;
+	}
+
+	if (!ReadProcessMemory(process.hProcess, (BYTE *)headerAddress, &key, sizeof(key), nullptr))
+	{
+		return false;
+	}
+
+	// Not in a party: every client is its own "party", keyed by its own server ID
+	if (key.allianceLeaderId == 0 && key.partyLeaderIds[0] == 0)
+	{
+		key.partyLeaderIds[0] = g_playerInstance ? g_playerInstance->getPlayerId(process.procId) : 0;
+		if (key.partyLeaderIds[0] == 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool PartyProperty::readMembers(const PlayerProcessInfo &process, PartySnapshot &snapshot) const
+{
+	uintptr_t tableAddress = FindDMAAddy(process.hProcess, process.dllBase + partyBaseOffset, partyOffsets);
+	if (tableAddress == 0)
+	{
+		return false;
+	}
+
+	// One range read for the whole alliance table
+	RawPartyMember raw[MAX_MEMBERS];
+	if (!ReadProcessMemory(process.hProcess, (BYTE *)tableAddress, raw, sizeof(raw), nullptr))
+	{
+		return false;
+	}
+
+	// Transpose into columns
+	snapshot.activeMask = 0;
+	for (size_t i = 0; i < MAX_MEMBERS; i++)
+	{
+		const RawPartyMember &member = raw[i];
+		if (!member.active || member.serverId == 0)
+		{
+			snapshot.serverIds[i] = 0;
+			snapshot.hp[i] = snapshot.mp[i] = snapshot.tp[i] = 0;
+			snapshot.hpp[i] = snapshot.mpp[i] = 0;
+			snapshot.zones[i] = 0;
+			snapshot.names[i].fill('\0');
+			continue;
+		}
+
+		snapshot.activeMask |= (1u << i);
+		snapshot.serverIds[i] = member.serverId;
+		snapshot.hp[i] = member.hp;
+		snapshot.mp[i] = member.mp;
+		snapshot.tp[i] = member.tp;
+		snapshot.hpp[i] = member.hpp;
+		snapshot.mpp[i] = member.mpp;
+		snapshot.zones[i] = member.zone;
+
+		size_t nameLength = strnlen(member.name, sizeof(member.name));
+		nameLength = std::min(nameLength, snapshot.names[i].size() - 1);
+		snapshot.names[i].fill('\0');
+		std::memcpy(snapshot.names[i].data(), member.name, nameLength);
+	}
+
+	// The table is empty while the client is zoning - treat as a failed read
+	return snapshot.activeMask != 0;
+}
+
+void PartyProperty::refresh(const PlayerProcessInfo &process)
+{
+	PartyKey key;
+	if (!readPartyKey(process, key))
+	{
+		return;
+	}
+
+	auto now = std::chrono::steady_clock::now();
+	bool shouldRead = false;
+
+	{
+		std::lock_guard<std::mutex> lock(propertyMutex);
+
+		// Moved to a different party - give up the reader role in the old one
+		auto previous = processParties.find(process.procId);
+		bool moved = previous != processParties.end() && !(previous->second == key);
+		if (moved)
+		{
+			auto oldParty = parties.find(previous->second);
+			if (oldParty != parties.end() && oldParty->second.readerProcId == process.procId)
+			{
+				oldParty->second.readerProcId = 0;
+			}
+		}
+		processParties[process.procId] = key;
+		if (moved)
+		{
+			pruneParties();
+		}
+
+		PartySnapshot &snapshot = parties[key];
+		bool readerAlive = snapshot.readerProcId != 0 &&
+		                   now - snapshot.lastRead < std::chrono::milliseconds(READER_TIMEOUT_MS);
+		if (readerAlive)
+		{
+			auto readerParty = processParties.find(snapshot.readerProcId);
+			readerAlive = readerParty != processParties.end() && readerParty->second == key;
+		}
+
+		shouldRead = !readerAlive || snapshot.readerProcId == process.procId;
+		if (!shouldRead)
+		{
+			sharedServes++;
+			return;
+		}
+	}
+
+	// Elected (or taking over): do the full read outside the lock
+	PartySnapshot fresh;
+	bool success = readMembers(process, fresh);
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	PartySnapshot &snapshot = parties[key];
+
+	if (!success)
+	{
+		// Zoning or logged out - let another member take over on its next tick
+		if (snapshot.readerProcId == process.procId)
+		{
+			snapshot.readerProcId = 0;
+		}
+		return;
+	}
+
+	fullReads++;
+	bool changed = fresh.activeMask != snapshot.activeMask ||
+	               fresh.serverIds != snapshot.serverIds ||
+	               fresh.hp != snapshot.hp ||
+	               fresh.mp != snapshot.mp ||
+	               fresh.tp != snapshot.tp ||
+	               fresh.zones != snapshot.zones;
+
+	if (snapshot.readerProcId != process.procId)
+	{
+		std::cout << "[Party] Process " << process.procId << " is now reading for its party" << std::endl;
+	}
+
+	if (changed)
+	{
+		fresh.version = snapshot.version + 1;
+	}
+	else
+	{
+		fresh.version = snapshot.version;
+	}
+	fresh.readerProcId = process.procId;
+	fresh.lastRead = now;
+	snapshot = fresh;
+
+	if (changed)
+	{
+		// Every client in the party sees the new values
+		for (const auto &pair : processParties)
+		{
+			if (pair.second == key)
+			{
+				bumpVersion(pair.first);
+			}
+		}
+	}
+}
+
+const char *PartyProperty::getPropertyName() const
+{
+	return "Party";
+}
+
+void PartyProperty::displayValue(DWORD procId) const
+{
+	PartySnapshot snapshot;
+	if (!getSnapshot(procId, snapshot))
+	{
+		std::cout << "Unknown";
+		return;
+	}
+
+	bool first = true;
+	for (size_t i = 0; i < MAX_MEMBERS; i++)
+	{
+		if (!(snapshot.activeMask & (1u << i)))
+		{
+			continue;
+		}
+		std::cout << (first ? "" : ", ") << snapshot.names[i].data() << " " << static_cast<int>(snapshot.hpp[i]) << "%";
+		first = false;
+	}
+	std::cout << (snapshot.readerProcId == procId ? " (reader)" : "");
+}
+
+bool PartyProperty::getSnapshot(DWORD procId, PartySnapshot &out) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto keyIt = processParties.find(procId);
+	if (keyIt == processParties.end())
+	{
+		return false;
+	}
+
+	auto partyIt = parties.find(keyIt->second);
+	if (partyIt == parties.end() || partyIt->second.activeMask == 0)
+	{
+		return false;
+	}
+
+	out = partyIt->second;
+	return true;
+}
+
+long long PartyProperty::getLowestHpp(DWORD procId) const
+{
+	PartySnapshot snapshot;
+	if (!getSnapshot(procId, snapshot))
+	{
+		return 100;
+	}
+
+	long long lowest = 100;
+	for (size_t i = 0; i < MAX_MEMBERS; i++)
+	{
+		if ((snapshot.activeMask & (1u << i)) && snapshot.hpp[i] < lowest)
+		{
+			lowest = snapshot.hpp[i];
+		}
+	}
+	return lowest;
+}
+
+long long PartyProperty::getNumericValue(DWORD procId) const
+{
+	return getLowestHpp(procId);
+}
+
+size_t PartyProperty::getPartyCount() const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	return parties.size();
+}
+
+uint64_t PartyProperty::getFullReadCount() const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	return fullReads;
+}
+
+uint64_t PartyProperty::getSharedServeCount() const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	return sharedServes;
+}
+
+bool PartyProperty::hasChanged(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto keyIt = processParties.find(procId);
+	if (keyIt == processParties.end())
+	{
+		return false;
+	}
+
+	// Only the reader publishes, so a six-box party posts once instead of six times
+	auto partyIt = parties.find(keyIt->second);
+	if (partyIt == parties.end() || partyIt->second.readerProcId != procId)
+	{
+		return false;
+	}
+
+	auto reportedIt = reportedVersions.find(procId);
+	uint64_t reported = (reportedIt != reportedVersions.end()) ? reportedIt->second : 0;
+	return partyIt->second.version != reported;
+}
+
+void PartyProperty::acknowledgeChange(DWORD procId)
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto keyIt = processParties.find(procId);
+	if (keyIt == processParties.end())
+	{
+		return;
+	}
+
+	auto partyIt = parties.find(keyIt->second);
+	if (partyIt != parties.end())
+	{
+		reportedVersions[procId] = partyIt->second.version;
+	}
+}
+
+void PartyProperty::onIdentityChanged(DWORD procId)
+{
+	PlayerProperty::onIdentityChanged(procId);
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto keyIt = processParties.find(procId);
+	if (keyIt != processParties.end())
+	{
+		auto partyIt = parties.find(keyIt->second);
+		if (partyIt != parties.end() && partyIt->second.readerProcId == procId)
+		{
+			partyIt->second.readerProcId = 0;
+		}
+		processParties.erase(keyIt);
+	}
+	reportedVersions.erase(procId);
+
+	pruneParties();
+}
+
+void PartyProperty::pruneParties()
+{
+	// Drop parties nobody belongs to any more
+	for (auto it = parties.begin(); it != parties.end();)
+	{
+		bool referenced = std::any_of(processParties.begin(), processParties.end(),
+		                              [&](const std::pair<const DWORD, PartyKey> &pair) { return pair.second == it->first; });
+		it = referenced ? std::next(it) : parties.erase(it);
+	}
+}
+
+void PartyProperty::reportChange(DWORD procId) const
+{
+	if (!g_playerInstance)
+	{
+		return;
+	}
+
+	PartySnapshot snapshot;
+	if (!getSnapshot(procId, snapshot))
+	{
+		return;
+	}
+
+	PartyKey key;
+	{
+		std::lock_guard<std::mutex> lock(propertyMutex);
+		auto keyIt = processParties.find(procId);
+		if (keyIt == processParties.end())
+		{
+			return;
+		}
+		key = keyIt->second;
+	}
+
+	std::ostringstream jsonPayload;
+	jsonPayload << "{"
+	           << "\"playerName\":\"" << escapeJsonString(g_playerInstance->getPlayerName(procId)) << "\","
+	           << "\"playerId\":" << g_playerInstance->getPlayerId(procId) << ","
+	           << "\"members\":[";
+
+	bool first = true;
+	for (size_t i = 0; i < MAX_MEMBERS; i++)
+	{
+		if (!(snapshot.activeMask & (1u << i)))
+		{
+			continue;
+		}
+
+		jsonPayload << (first ? "" : ",") << "{"
+		           << "\"slot\":" << i << ","
+		           << "\"id\":" << snapshot.serverIds[i] << ","
+		           << "\"name\":\"" << escapeJsonString(snapshot.names[i].data()) << "\","
+		           << "\"hp\":" << snapshot.hp[i] << ","
+		           << "\"mp\":" << snapshot.mp[i] << ","
+		           << "\"tp\":" << snapshot.tp[i] << ","
+		           << "\"hpp\":" << static_cast<int>(snapshot.hpp[i]) << ","
+		           << "\"mpp\":" << static_cast<int>(snapshot.mpp[i]) << ","
+		           << "\"zone\":" << snapshot.zones[i] << "}";
+		first = false;
+	}
+	jsonPayload << "]}";
+
+	// Keyed by the party rather than by the reader, so a failover doesn't post the same state twice
+	std::ostringstream slotKey;
+	slotKey << getPropertyName() << "#" << key.allianceLeaderId << ":" << key.partyLeaderIds[0];
+	g_playerInstance->getChangePublisher().publish(0, slotKey.str(), API_ENDPOINT, jsonPayload.str());
+}
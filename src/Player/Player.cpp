@@ -1,63 +1,32 @@
 #include <Windows.h>
 #include "Player/Player.h"
 #include "Player/TacticalPointsProperty.h"
+#include "Player/DerivedProperty.h"
+#include "Player/StatusEffectProperty.h"
+#include "Player/OwnershipProperty.h"
+#include "Player/PartyProperty.h"
+#include "Player/EntityProperty.h"
+#include "Player/InventoryProperty.h"
+#include "Player/EnvironmentProperty.h"
+#include "Player/RecastProperty.h"
+#include "Player/TargetProperty.h"
+#include "Player/PositionProperty.h"
 #include "Player/ChatLogProperty.h"
 #include "Player/EliteAPI.h"
 #include "helpers/memory.h"
 #include "helpers/http.h"
 #include "helpers/logger.h"
+#include "helpers/ffxitext.h"
 #include <iostream>
 #include <chrono>
 #include <thread>
 #include <sstream>
 #include <iomanip>
 
-// Helper function to escape strings for JSON
+// Helper function to escape strings for JSON (drops FFXI control codes, Shift-JIS text comes out as UTF-8)
 std::string escapeJsonString(const std::string &input)
 {
-	std::ostringstream escaped;
-	for (unsigned char c : input)
-	{
-		// Skip or escape control characters (0x00-0x1F and 0x7F-0xFF)
-		if (c < 0x20 || c >= 0x7F)
-		{
-			// Skip FFXI control/color codes
-			continue;
-		}
-		else if (c == '"')
-		{
-			escaped << "\\\"";
-		}
-		else if (c == '\\')
-		{
-			escaped << "\\\\";
-		}
-		else if (c == '\b')
-		{
-			escaped << "\\b";
-		}
-		else if (c == '\f')
-		{
-			escaped << "\\f";
-		}
-		else if (c == '\n')
-		{
-			escaped << "\\n";
-		}
-		else if (c == '\r')
-		{
-			escaped << "\\r";
-		}
-		else if (c == '\t')
-		{
-			escaped << "\\t";
-		}
-		else
-		{
-			escaped << c;
-		}
-	}
-	return escaped.str();
+	return FFXIText::decode(input, FFXIText::Profile::Json);
 }
 
 // Initialize static members
@@ -67,14 +36,30 @@ std::map<DWORD, PlayerProcessInfo> Player::processes;
 const std::vector<unsigned int> Player::PLAYER_NAME_OFFSETS = {0xA4};
 const std::vector<unsigned int> Player::PLAYER_ID_OFFSETS = {0x4E0};
 const std::vector<unsigned int> Player::PLAYER_CONQUEST_OFFSETS = {0x8C};
+const std::vector<unsigned int> Player::VANA_TIME_OFFSETS = {0x00};
 
-// For TacticalPointsProperty to access player names
-extern Player *g_playerInstance;
+// Generated by tools/resgen at build time, next to the executable
+const char *Player::RESOURCE_FILE = "ffxi_resources.bin";
 
 Player::Player() : monitoringActive(false), chatMonitoringEnabled(false), shutdownChatMonitoring(false)
 {
 	// Set the global instance for properties to access
 	g_playerInstance = this;
+	// Map static game data before anything needs names
+	if (resources.open(RESOURCE_FILE))
+	{
+		std::cout << "Loaded game data: " << resources.getRecordCount(ResourceTables::Kind::Items) << " items, "
+		          << resources.getRecordCount(ResourceTables::Kind::Spells) << " spells, "
+		          << resources.getRecordCount(ResourceTables::Kind::Abilities) << " abilities, "
+		          << resources.getRecordCount(ResourceTables::Kind::Zones) << " zones, "
+		          << resources.getRecordCount(ResourceTables::Kind::AutoTranslate) << " auto-translate phrases" << std::endl;
+		FFXIText::setPhraseTable(&resources);
+	}
+	else
+	{
+		std::cout << "Game data file " << RESOURCE_FILE << " not found; events will carry IDs only" << std::endl;
+	}
+
 	// Initialize processes first
 	initializeProcesses();
 
@@ -83,6 +68,15 @@ Player::Player() : monitoringActive(false), chatMonitoringEnabled(false), shutdo
 
 	// TEMPORARILY DISABLED: Register tactical points for continuous monitoring (update every 100ms)
 	// registerProperty(std::make_shared<TacticalPointsProperty>(), 100);
+	// registerProperty(std::make_shared<StatusEffectProperty>(), 250);
+	// registerProperty(std::make_shared<OwnershipProperty>(), 30000);
+	// registerProperty(std::make_shared<PartyProperty>(), 250);
+	// registerProperty(std::make_shared<EntityProperty>(), 500);
+	// registerProperty(std::make_shared<InventoryProperty>(), 10000);
+	// registerProperty(std::make_shared<EnvironmentProperty>(), 1000);
+	// registerProperty(std::make_shared<RecastProperty>(), 250);
+	// registerProperty(std::make_shared<TargetProperty>(), 100);
+	// registerProperty(std::make_shared<PositionProperty>(), 100);
 
 	// Refresh all dynamic properties initially
 	refreshAllProperties();
@@ -119,6 +113,9 @@ Player::~Player()
 			pair.second.hProcess = NULL;
 		}
 	}
+
+	// The phrase table points into resources, which go away with this object
+	FFXIText::setPhraseTable(nullptr);
 }
 
 void Player::initializeProcesses()
@@ -196,6 +193,11 @@ void Player::readStaticProperties()
 		{
 			readPlayerName(pair.second);
 			readPlayerId(pair.second);
+
+			if (!vanaClock.isVerified())
+			{
+				verifyVanaClock(pair.second);
+			}
 		}
 	}
 
@@ -211,6 +213,18 @@ void Player::readStaticProperties()
 }
 
 void Player::readPlayerName(const PlayerProcessInfo &process)
+{
+	std::string previousName = getPlayerName(process.procId);
+	readPlayerNameFromMemory(process);
+
+	// Subscriptions on character mentions are compiled against the current names
+	if (getPlayerName(process.procId) != previousName)
+	{
+		rebuildChatFilter();
+	}
+}
+
+void Player::readPlayerNameFromMemory(const PlayerProcessInfo &process)
 {
 	// Get player name address
 	uintptr_t nameAddress = FindDMAAddyInDLL(
@@ -223,7 +237,7 @@ void Player::readPlayerName(const PlayerProcessInfo &process)
 	if (nameAddress == 0)
 	{
 		std::cout << "Failed to find player name address for process " << process.procId << std::endl;
-		playerNames[process.procId] = "Unknown";
+		storePlayerName(process.procId, "Unknown");
 		return;
 	}
 
@@ -268,25 +282,25 @@ void Player::readPlayerName(const PlayerProcessInfo &process)
 
 			if (!rawName.empty() && rawName.length() > 1)
 			{
-				playerNames[process.procId] = rawName;
+				storePlayerName(process.procId, rawName);
 				std::cout << "Successfully read player name: '" << rawName << "' for process " << process.procId << std::endl;
 			}
 			else
 			{
-				playerNames[process.procId] = "Unknown";
+				storePlayerName(process.procId, "Unknown");
 				std::cout << "Player name was empty or too short for process " << process.procId << std::endl;
 			}
 		}
 		else
 		{
-			playerNames[process.procId] = "Unknown";
+			storePlayerName(process.procId, "Unknown");
 			std::cout << "Invalid player name data for process " << process.procId << std::endl;
 		}
 	}
 	else
 	{
 		std::cout << "Failed to read player name memory for process " << process.procId << std::endl;
-		playerNames[process.procId] = "Unknown";
+		storePlayerName(process.procId, "Unknown");
 	}
 }
 
@@ -315,6 +329,7 @@ void Player::readPlayerId(const PlayerProcessInfo &process)
 		if (playerId > 0)
 		{
 			playerIds[process.procId] = playerId;
+			lastKnownPlayerIds[process.procId] = playerId;
 			std::cout << "Successfully read player ID: " << playerId << " for process " << process.procId << std::endl;
 		}
 		else
@@ -330,7 +345,95 @@ void Player::readPlayerId(const PlayerProcessInfo &process)
 	}
 }
 
+DWORD Player::readPlayerIdSentinel(const PlayerProcessInfo &process) const
+{
+	// Chase the pointer from the cached DLL base instead of re-enumerating modules
+	uintptr_t idAddress = FindDMAAddy(process.hProcess, process.dllBase + PLAYER_ID_OFFSET_BASE, PLAYER_ID_OFFSETS);
+	if (idAddress == 0)
+	{
+		return 0;
+	}
+
+	DWORD playerId = 0;
+	if (!ReadProcessMemory(process.hProcess, (BYTE *)idAddress, &playerId, sizeof(playerId), nullptr))
+	{
+		return 0;
+	}
+	return playerId;
+}
+
+void Player::checkForCharacterSwitches()
+{
+	for (const auto &pair : processes)
+	{
+		if (!pair.second.isValid)
+		{
+			continue;
+		}
+
+		// 0 means a failed read as well as logged out or zoning; neither is a different character
+		DWORD sentinel = readPlayerIdSentinel(pair.second);
+		if (sentinel == 0)
+		{
+			continue;
+		}
+
+		auto known = lastKnownPlayerIds.find(pair.first);
+		if (known != lastKnownPlayerIds.end() && known->second == sentinel)
+		{
+			// Same character back after a gap (e.g. an earlier failed ID read)
+			playerIds[pair.first] = sentinel;
+			continue;
+		}
+
+		onCharacterSwitch(pair.second, sentinel);
+	}
+}
+
+void Player::onCharacterSwitch(const PlayerProcessInfo &process, DWORD newPlayerId)
+{
+	DWORD procId = process.procId;
+	std::cout << "Player ID changed for process " << procId << ": " << getPlayerId(procId)
+						<< " -> " << newPlayerId << std::endl;
+
+	playerIds[procId] = newPlayerId;
+	lastKnownPlayerIds[procId] = newPlayerId;
+
+	// Incremental identity re-read: only the name is missing, no retry sleeps
+	readPlayerName(process);
+
+	// Invalidate identity-keyed state so the new character starts fresh
+	for (auto &config : propertyConfigs)
+	{
+		config.property->onIdentityChanged(procId);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(chatMutex);
+		processChats[procId].clear();
+	}
+}
+
 // Process lifecycle management methods
+void Player::verifyVanaClock(const PlayerProcessInfo &process)
+{
+	uintptr_t timeAddress = FindDMAAddy(process.hProcess, process.dllBase + VANA_TIME_OFFSET_BASE, VANA_TIME_OFFSETS);
+	if (timeAddress == 0)
+	{
+		return;
+	}
+
+	// The client's clock is a 32-bit count of Earth seconds
+	uint32_t clientSeconds = 0;
+	if (!ReadProcessMemory(process.hProcess, (BYTE *)timeAddress, &clientSeconds, sizeof(clientSeconds), nullptr) || clientSeconds == 0)
+	{
+		std::cout << "Failed to read Vana'diel time for process " << process.procId << "; using computed clock" << std::endl;
+		return;
+	}
+
+	vanaClock.verify(VanaClock::fromClientSeconds(clientSeconds), std::chrono::system_clock::now());
+}
+
 bool Player::isProcessAlive(DWORD procId) const
 {
 	auto it = processes.find(procId);
@@ -381,8 +484,21 @@ void Player::cleanupDeadProcess(DWORD procId)
 		processes.erase(it);
 
 		// Remove from player names and IDs maps
-		playerNames.erase(procId);
+		{
+			std::lock_guard<std::mutex> nameLock(playerNameMutex);
+			playerNames.erase(procId);
+			actorNames.erase(procId);
+		}
 		playerIds.erase(procId);
+		lastKnownPlayerIds.erase(procId);
+
+		// Drop identity-keyed state so a reused process ID starts fresh
+		for (auto &config : propertyConfigs)
+		{
+			config.property->onIdentityChanged(procId);
+		}
+
+		rebuildChatFilter();
 	}
 }
 
@@ -494,6 +610,11 @@ void Player::checkForNewProcesses()
 			}
 		}
 
+		if (successfullyReadData && !vanaClock.isVerified())
+		{
+			verifyVanaClock(info);
+		}
+
 		if (!successfullyReadData)
 		{
 			std::cout << "WARNING: Failed to read player data after " << maxRetries << " attempts. Process " << procId << " may not be fully loaded yet." << std::endl;
@@ -530,13 +651,51 @@ bool Player::isValidProcess(DWORD procId) const
 	return (it != processes.end() && it->second.isValid);
 }
 
-void Player::registerProperty(std::shared_ptr<PlayerProperty> property, unsigned int intervalMs)
+void Player::registerProperty(std::shared_ptr<PlayerProperty> property, unsigned int intervalMs, bool publishChanges)
+{
+	addPropertyConfig(property, intervalMs, nullptr, publishChanges);
+}
+
+bool Player::registerDerivedProperty(std::shared_ptr<DerivedProperty> property, unsigned int intervalMs)
+{
+	// Every input must already be registered so it is refreshed earlier in the same tick
+	for (const auto &input : property->getInputs())
+	{
+		bool registered = false;
+		for (const auto &config : propertyConfigs)
+		{
+			if (config.property == input)
+			{
+				registered = true;
+				break;
+			}
+		}
+
+		if (!registered)
+		{
+			std::cout << "Cannot register derived property " << property->getPropertyName()
+								<< ": input " << (input ? input->getPropertyName() : "(null)") << " is not registered" << std::endl;
+			return false;
+		}
+	}
+
+	addPropertyConfig(property, intervalMs, nullptr, true);
+	return true;
+}
+
+size_t Player::addPropertyConfig(std::shared_ptr<PlayerProperty> property, unsigned int intervalMs, PropertyTypeId typeId, bool publishChanges)
 {
 	PropertyConfig config;
 	config.property = property;
 	config.monitoringIntervalMs = (intervalMs > 0) ? intervalMs : defaultMonitoringIntervalMs;
 	config.lastUpdateTime = std::chrono::steady_clock::now();
+	config.publishChanges = publishChanges;
 	propertyConfigs.push_back(config);
+
+	size_t slot = propertyConfigs.size() - 1;
+	propertyRegistry.bind(typeId, property->getPropertyName(), slot);
+	recastProperty = findProperty<RecastProperty>();
+	return slot;
 }
 
 void Player::refreshAllProperties()
@@ -589,11 +748,17 @@ void Player::displayAllPlayerData() const
 		}
 		std::cout << std::endl;
 	}
+
+	ChangePublisher::Stats stats = changePublisher.getStats();
+	std::cout << "Publisher: " << stats.enqueued << " enqueued, " << stats.sent << " sent, "
+						<< stats.coalesced << " coalesced, " << stats.dropped << " dropped, "
+						<< stats.failed << " failed, " << stats.retried << " retried" << std::endl;
 }
 
 // Convenience methods for common properties
 std::string Player::getPlayerName(DWORD procId) const
 {
+	std::lock_guard<std::mutex> lock(playerNameMutex);
 	auto it = playerNames.find(procId);
 	return (it != playerNames.end()) ? it->second : "Unknown";
 }
@@ -606,27 +771,16 @@ DWORD Player::getPlayerId(DWORD procId) const
 
 int Player::getTacticalPoints(DWORD procId) const
 {
-	for (const auto &config : propertyConfigs)
-	{
-		auto tpProperty = dynamic_cast<TacticalPointsProperty *>(config.property.get());
-		if (tpProperty)
-		{
-			std::cout << "Getting Tactical Points for process ID: " << procId << std::endl;
-			return tpProperty->getTP(procId);
-		}
-	}
-	return 0;
+	auto tpProperty = findProperty<TacticalPointsProperty>();
+	return tpProperty ? tpProperty->getTP(procId) : 0;
 }
 
 void Player::setPropertyRefreshInterval(const char *propertyName, unsigned int intervalMs)
 {
-	for (auto &config : propertyConfigs)
+	size_t slot = propertyRegistry.findByName(propertyName);
+	if (slot != PropertyRegistry::npos)
 	{
-		if (strcmp(config.property->getPropertyName(), propertyName) == 0)
-		{
-			config.monitoringIntervalMs = intervalMs;
-			break;
-		}
+		propertyConfigs[slot].monitoringIntervalMs = intervalMs;
 	}
 }
 
@@ -660,25 +814,18 @@ void Player::refreshProperty(const char *propertyName)
 	}
 
 	// Otherwise, look for the property in the monitored properties
-	std::shared_ptr<PlayerProperty> targetProperty = nullptr;
-
-	for (auto &config : propertyConfigs)
-	{
-		if (strcmp(config.property->getPropertyName(), propertyName) == 0)
-		{
-			targetProperty = config.property;
-			// Reset last update time
-			config.lastUpdateTime = std::chrono::steady_clock::now();
-			break;
-		}
-	}
-
-	if (!targetProperty)
+	size_t slot = propertyRegistry.findByName(propertyName);
+	if (slot == PropertyRegistry::npos)
 	{
 		std::cout << "Property not found: " << propertyName << std::endl;
 		return;
 	}
 
+	std::shared_ptr<PlayerProperty> targetProperty = propertyConfigs[slot].property;
+
+	// Reset last update time
+	propertyConfigs[slot].lastUpdateTime = std::chrono::steady_clock::now();
+
 	// Refresh for all valid processes
 	for (const auto &pair : processes)
 	{
@@ -744,6 +891,8 @@ void Player::startMonitoring()
 	if (monitoringActive)
 		return; // Already monitoring
 
+	changePublisher.start();
+
 	monitoringActive = true;
 	monitorThread = std::thread(&Player::monitorPropertiesThread, this);
 }
@@ -758,6 +907,8 @@ void Player::stopMonitoring()
 	{
 		monitorThread.join();
 	}
+
+	changePublisher.stop();
 }
 
 void Player::setMonitoringInterval(unsigned int intervalMs)
@@ -773,6 +924,21 @@ bool Player::isMonitoring() const
 	return monitoringActive;
 }
 
+ChangePublisher &Player::getChangePublisher()
+{
+	return changePublisher;
+}
+
+const ResourceTables &Player::getResources() const
+{
+	return resources;
+}
+
+const VanaClock &Player::getVanaClock() const
+{
+	return vanaClock;
+}
+
 void Player::monitorPropertiesThread()
 {
 	std::cout << "Monitoring thread started" << std::endl;
@@ -781,6 +947,8 @@ void Player::monitorPropertiesThread()
 	// Track time for process lifecycle checks
 	auto lastProcessCheckTime = std::chrono::steady_clock::now();
 	const auto processCheckInterval = std::chrono::seconds(2); // Check for dead/new processes every 2 seconds
+	auto lastIdentityCheckTime = lastProcessCheckTime;
+	const auto identityCheckInterval = std::chrono::seconds(1); // Check for character switches every second
 
 	try
 	{
@@ -798,6 +966,13 @@ void Player::monitorPropertiesThread()
 					lastProcessCheckTime = currentTime;
 				}
 
+				// Slow tier: poll the player ID word to catch logout/login to another character
+				if (currentTime - lastIdentityCheckTime >= identityCheckInterval)
+				{
+					checkForCharacterSwitches();
+					lastIdentityCheckTime = currentTime;
+				}
+
 				// Check each property if it's time to update
 				for (auto &config : propertyConfigs)
 				{
@@ -822,8 +997,8 @@ void Player::monitorPropertiesThread()
 									// Refresh the property
 									config.property->refresh(pair.second);
 
-									// Check if the property has changed
-									if (config.property->hasChanged(pair.first))
+									// Check if the property has changed (input-only properties are never published)
+									if (config.publishChanges && config.property->hasChanged(pair.first))
 									{
 										// Report the change
 										config.property->reportChange(pair.first);
@@ -942,7 +1117,7 @@ void Player::enableChatMonitoring()
 						LOG_FLUSH();
 
 						// Register chat callback
-						eliteAPI->RegisterChatCallback([this, procId](const ChatMessage &msg)
+						eliteAPI->RegisterChatCallback([this, procId](const ChatMessageView &msg)
 																					 { this->onChatMessage(procId, msg); });
 
 						LOG("PLAYER", "Chat callback registered, about to start monitoring");
@@ -1102,8 +1277,36 @@ void Player::disableChatMonitoring()
 	std::cout << "[Player] Chat monitoring disabled" << std::endl;
 }
 
-void Player::onChatMessage(DWORD procId, const ChatMessage &msg)
+void Player::onChatMessage(DWORD procId, const ChatMessageView &msg)
 {
+	// The character's own action messages mean a recast just started - resync instead of waiting
+	if (recastProperty)
+	{
+		FixedString<16> actor;
+		{
+			std::lock_guard<std::mutex> lock(playerNameMutex);
+			auto it = actorNames.find(procId);
+			if (it != actorNames.end())
+			{
+				actor = it->second;
+			}
+		}
+
+		std::string_view playerName = actor.view();
+		if (!playerName.empty() && msg.message.compare(0, playerName.size(), playerName) == 0)
+		{
+			static const char *const actionVerbs[] = {" uses ", " casts ", " starts casting ", " readies "};
+			for (const char *verb : actionVerbs)
+			{
+				if (msg.message.find(verb, playerName.size()) == playerName.size())
+				{
+					recastProperty->requestResync(procId);
+					break;
+				}
+			}
+		}
+	}
+
 	// Skip UNKNOWN message types - don't store or send them
 	if (msg.type == ChatMessageType::Unknown)
 	{
@@ -1113,19 +1316,23 @@ void Player::onChatMessage(DWORD procId, const ChatMessage &msg)
 
 	std::lock_guard<std::mutex> lock(chatMutex);
 
-	// Store message
-	processChats[procId].push_back(msg);
-
-	// Keep only last 100 messages per process
-	if (processChats[procId].size() > 100)
+	// Lines no subscription wants are dropped here rather than on the server
+	if (!chatFilter.matches(msg))
 	{
-		processChats[procId].pop_front();
+		return;
 	}
 
+	// Store message (its text is copied once, into the batch's arena)
+	ChatBatch &batch = processChats[procId];
+	batch.append(msg);
+
+	// Keep only last 100 messages per process
+	batch.trimTo(100);
+
 	// Get player name for better logging
 	std::string playerName = getPlayerName(procId);
 	std::cout << "[Chat][" << playerName << " PID:" << procId << "] "
-						<< msg.sender << " (" << msg.getMessageTypeString()
+						<< msg.senderPrefix << msg.sender << " (" << msg.getMessageTypeString()
 						<< "): " << msg.message << std::endl;
 
 	// Update last chat time for debouncing
@@ -1148,20 +1355,83 @@ void Player::onChatMessage(DWORD procId, const ChatMessage &msg)
 	}
 }
 
+void Player::setChatSubscriptions(std::vector<ChatSubscription> subscriptions)
+{
+	{
+		std::lock_guard<std::mutex> lock(chatMutex);
+		chatSubscriptions = std::move(subscriptions);
+	}
+	rebuildChatFilter();
+}
+
+void Player::storePlayerName(DWORD procId, const std::string &name)
+{
+	std::lock_guard<std::mutex> lock(playerNameMutex);
+	playerNames[procId] = name;
+	if (name != "Unknown")
+	{
+		actorNames[procId].assign(name);
+	}
+	else
+	{
+		actorNames.erase(procId);
+	}
+}
+
+void Player::rebuildChatFilter()
+{
+	// Snapshot the inputs, compile without blocking chat delivery, then swap the result in
+	std::lock_guard<std::mutex> buildLock(chatFilterBuildMutex);
+
+	std::vector<std::string> characterNames;
+	{
+		std::lock_guard<std::mutex> lock(playerNameMutex);
+		for (const auto &pair : playerNames)
+		{
+			if (pair.second != "Unknown")
+			{
+				characterNames.push_back(pair.second);
+			}
+		}
+	}
+
+	std::vector<ChatSubscription> subscriptions;
+	{
+		std::lock_guard<std::mutex> lock(chatMutex);
+		subscriptions = chatSubscriptions;
+	}
+
+	ChatFilter filter;
+	if (!filter.compile(subscriptions, characterNames))
+	{
+		std::cout << "[Chat] Only the first " << ChatFilter::MAX_SUBSCRIPTIONS << " of "
+							<< subscriptions.size() << " chat subscriptions are used" << std::endl;
+	}
+	if (!filter.empty())
+	{
+		std::cout << "[Chat] Filter compiled: " << subscriptions.size() << " subscriptions, "
+							<< filter.patternCount() << " patterns, " << filter.stateCount() << " states" << std::endl;
+	}
+
+	std::lock_guard<std::mutex> chatLock(chatMutex);
+	chatFilter = std::move(filter);
+}
+
 std::vector<ChatMessage> Player::getRecentChatMessages(DWORD procId, int count)
 {
 	std::lock_guard<std::mutex> lock(chatMutex);
 
 	std::vector<ChatMessage> messages;
 
-	if (processChats.find(procId) != processChats.end())
+	auto it = processChats.find(procId);
+	if (it != processChats.end())
 	{
-		auto &deque = processChats[procId];
-		int start = std::max(0, static_cast<int>(deque.size()) - count);
+		const ChatBatch &batch = it->second;
+		int start = std::max(0, static_cast<int>(batch.size()) - count);
 
-		for (size_t i = start; i < deque.size(); i++)
+		for (size_t i = start; i < batch.size(); i++)
 		{
-			messages.push_back(deque[i]);
+			messages.push_back(batch.materialize(i));
 		}
 	}
 
@@ -1200,15 +1470,11 @@ void Player::chatDebounceThread(DWORD procId)
 
 		if (shouldSend)
 		{
-			// Send the batch
-			std::vector<ChatMessage> batch;
+			// Send the batch (taken whole, arena and all)
+			ChatBatch batch;
 			{
 				std::lock_guard<std::mutex> lock(chatMutex);
-				for (const auto &msg : processChats[procId])
-				{
-					batch.push_back(msg);
-				}
-				processChats[procId].clear();
+				batch.swap(processChats[procId]);
 			}
 
 			std::cout << "[Chat] Debounce complete, sending " << batch.size()
@@ -1226,7 +1492,7 @@ void Player::chatDebounceThread(DWORD procId)
 	debounceThreadRunning[procId] = false;
 }
 
-void Player::sendChatBatch(DWORD procId, const std::vector<ChatMessage> &messages)
+void Player::sendChatBatch(DWORD procId, const ChatBatch &messages)
 {
 	if (messages.empty())
 	{
@@ -1246,13 +1512,13 @@ void Player::sendChatBatch(DWORD procId, const std::vector<ChatMessage> &message
 	try
 	{
 		// Group messages by type
-		std::map<std::string, std::vector<std::string>> messagesByType;
+		std::map<std::string, std::vector<std::string_view>> messagesByType;
 
-		for (const auto &msg : messages)
+		for (size_t i = 0; i < messages.size(); i++)
 		{
-			std::string typeKey = msg.getMessageTypeString();
+			ChatMessageView msg = messages.at(i);
 			// Use the original raw content to preserve formatting
-			messagesByType[typeKey].push_back(msg.rawContent);
+			messagesByType[msg.getMessageTypeString()].push_back(msg.rawContent);
 		}
 
 		// Send each message type as a separate request
@@ -1272,7 +1538,7 @@ void Player::sendChatBatch(DWORD procId, const std::vector<ChatMessage> &message
 				if (i > 0)
 					json << ",";
 				// Use 1-based indexing (Lua convention)
-				json << "\"" << (i + 1) << "\":\"" << escapeJsonString(msgList[i]) << "\"";
+				json << "\"" << (i + 1) << "\":\"" << escapeJsonString(std::string(msgList[i])) << "\"";
 			}
 
 			json << "}}";
@@ -1310,7 +1576,7 @@ void Player::sendChatBatch(DWORD procId, const std::vector<ChatMessage> &message
 
 void Player::sendChatMessagesToServer(DWORD procId)
 {
-	std::vector<ChatMessage> messages;
+	ChatBatch messages;
 
 	{
 		std::lock_guard<std::mutex> lock(chatMutex);
@@ -1321,13 +1587,8 @@ void Player::sendChatMessagesToServer(DWORD procId)
 			return;
 		}
 
-		// Copy messages
-		for (const auto &msg : processChats[procId])
-		{
-			messages.push_back(msg);
-		}
-
-		processChats[procId].clear();
+		// Take the pending batch
+		messages.swap(processChats[procId]);
 	}
 
 	std::cout << "[Chat] Manually sending " << messages.size()
@@ -1336,3 +1597,61 @@ void Player::sendChatMessagesToServer(DWORD procId)
 	// Send immediately (not in background thread since this is manual)
 	sendChatBatch(procId, messages);
 }
+
+// PlayerProperty versioning and change policy helpers
+uint64_t PlayerProperty::getVersion(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = versions.find(procId);
+	return (it != versions.end()) ? it->second : 0;
+}
+
+void PlayerProperty::bumpVersion(DWORD procId)
+{
+	versions[procId]++;
+}
+
+void PlayerProperty::onIdentityChanged(DWORD procId)
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	lastReportedValues.erase(procId);
+	if (changePolicy)
+	{
+		changePolicy->reset(procId);
+	}
+	bumpVersion(procId);
+}
+
+void PlayerProperty::setChangePolicy(std::shared_ptr<ChangePolicy> policy)
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	changePolicy = policy;
+}
+
+bool PlayerProperty::passesChangePolicy(DWORD procId, long long currentValue) const
+{
+	auto it = lastReportedValues.find(procId);
+	long long lastReported = (it != lastReportedValues.end()) ? it->second : 0;
+
+	if (currentValue == lastReported)
+	{
+		return false;
+	}
+
+	if (!changePolicy)
+	{
+		return true;
+	}
+
+	return changePolicy->shouldReport(procId, lastReported, currentValue, std::chrono::steady_clock::now());
+}
+
+void PlayerProperty::recordReportedValue(DWORD procId, long long value)
+{
+	lastReportedValues[procId] = value;
+
+	if (changePolicy)
+	{
+		changePolicy->onReported(procId, value, std::chrono::steady_clock::now());
+	}
+}
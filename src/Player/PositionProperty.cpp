@@ -0,0 +1,215 @@
+#include "Player/PositionProperty.h"
+#include "Player/EnvironmentProperty.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+// Static API endpoint definition
+const std::string PositionProperty::API_ENDPOINT = "http://192.168.5.30:8080/set_position";
+
+PositionProperty::PositionProperty()
+{
+}
+
+int32_t PositionProperty::quantize(float value)
+{
+	return static_cast<int32_t>(std::lround(value * POSITION_SCALE));
+}
+
+void PositionProperty::refresh(const PlayerProcessInfo &process)
+{
+	uintptr_t entityAddress = FindDMAAddy(process.hProcess, process.dllBase + localEntityOffset, localEntityOffsets);
+	if (entityAddress == 0)
+	{
+		return;
+	}
+
+	// Position through speed in one read
+	uint8_t raw[EntityLayout::SPEED + sizeof(float) - EntityLayout::POS_X];
+	if (!ReadProcessMemory(process.hProcess, (BYTE *)(entityAddress + EntityLayout::POS_X), raw, sizeof(raw), nullptr))
+	{
+		return;
+	}
+
+	Position sample;
+	float speed;
+	std::memcpy(&sample.x, raw, sizeof(float));
+	std::memcpy(&sample.y, raw + (EntityLayout::POS_Y - EntityLayout::POS_X), sizeof(float));
+	std::memcpy(&sample.z, raw + (EntityLayout::POS_Z - EntityLayout::POS_X), sizeof(float));
+	std::memcpy(&sample.heading, raw + (EntityLayout::HEADING - EntityLayout::POS_X), sizeof(float));
+	std::memcpy(&speed, raw + (EntityLayout::SPEED - EntityLayout::POS_X), sizeof(float));
+
+	if (g_playerInstance)
+	{
+		if (auto environment = g_playerInstance->findProperty<EnvironmentProperty>())
+		{
+			sample.zone = environment->getZone(process.procId);
+		}
+	}
+
+	auto now = std::chrono::steady_clock::now();
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	PositionState &state = states[process.procId];
+
+	// The speed field is the movement speed stat, so only apply it while the character is actually moving
+	float stepX = sample.x - state.current.x;
+	float stepY = sample.y - state.current.y;
+	float step = std::sqrt(stepX * stepX + stepY * stepY);
+	bool moving = state.loaded && step > MOVE_EPSILON;
+	sample.speed = moving ? speed : 0.0f;
+
+	bool emit = false;
+	if (!state.loaded || sample.zone != state.current.zone || step > TELEPORT_DISTANCE ||
+	    now - state.lastKeyframe >= std::chrono::milliseconds(KEYFRAME_INTERVAL_MS))
+	{
+		state.keyframe = true;
+		emit = true;
+	}
+	else
+	{
+		// Compare against where the consumer thinks the character is
+		float elapsed = std::chrono::duration<float>(now - state.anchorTime).count();
+		float errorX = sample.x - (state.anchor.x + state.velocityX * elapsed);
+		float errorY = sample.y - (state.anchor.y + state.velocityY * elapsed);
+		float errorZ = sample.z - state.anchor.z;
+		emit = std::sqrt(errorX * errorX + errorY * errorY) > POSITION_TOLERANCE || std::fabs(errorZ) > POSITION_TOLERANCE;
+	}
+
+	state.current = sample;
+	state.loaded = true;
+
+	if (emit)
+	{
+		// Client heading: 0 faces east (+X), increasing turns towards -Y
+		state.anchor = sample;
+		state.velocityX = sample.speed * std::cos(sample.heading);
+		state.velocityY = -sample.speed * std::sin(sample.heading);
+		state.anchorTime = now;
+		state.anchorWallTime = std::chrono::system_clock::now();
+		if (!state.pending)
+		{
+			state.pending = true;
+			bumpVersion(process.procId);
+		}
+	}
+}
+
+PositionProperty::Position PositionProperty::getPosition(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	return (it != states.end()) ? it->second.current : Position();
+}
+
+const char *PositionProperty::getPropertyName() const
+{
+	return "Position";
+}
+
+void PositionProperty::displayValue(DWORD procId) const
+{
+	Position position = getPosition(procId);
+	std::cout << "(" << position.x << ", " << position.y << ", " << position.z << ") zone " << position.zone;
+}
+
+long long PositionProperty::getNumericValue(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	return (it != states.end()) ? it->second.sequence : 0;
+}
+
+bool PositionProperty::hasChanged(DWORD procId) const
+{
+	// A lost delta leaves the receiver off by its offset until a keyframe; send one right away
+	bool lost = g_playerInstance && g_playerInstance->getChangePublisher().isLost(procId, getPropertyName());
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	return it != states.end() && (it->second.pending || lost);
+}
+
+void PositionProperty::acknowledgeChange(DWORD procId)
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	if (it == states.end())
+	{
+		return;
+	}
+
+	// The consumer now holds the quantized anchor; the next delta is taken from there
+	PositionState &state = it->second;
+	state.sentX = quantize(state.anchor.x);
+	state.sentY = quantize(state.anchor.y);
+	state.sentZ = quantize(state.anchor.z);
+	if (state.keyframe)
+	{
+		state.keyframe = false;
+		state.lastKeyframe = state.anchorTime;
+	}
+	state.sequence++;
+	state.pending = false;
+}
+
+void PositionProperty::onIdentityChanged(DWORD procId)
+{
+	PlayerProperty::onIdentityChanged(procId);
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	states.erase(procId);
+}
+
+void PositionProperty::reportChange(DWORD procId) const
+{
+	if (!g_playerInstance)
+	{
+		return;
+	}
+
+	bool lost = g_playerInstance->getChangePublisher().takeLost(procId, getPropertyName());
+
+	std::ostringstream jsonPayload;
+	jsonPayload << "{"
+	           << "\"playerName\":\"" << escapeJsonString(g_playerInstance->getPlayerName(procId)) << "\","
+	           << "\"playerId\":" << g_playerInstance->getPlayerId(procId) << ",";
+
+	{
+		std::lock_guard<std::mutex> lock(propertyMutex);
+		auto it = states.find(procId);
+		if (it == states.end())
+		{
+			return;
+		}
+
+		const PositionState &state = it->second;
+		bool keyframe = state.keyframe || lost;
+		int32_t x = quantize(state.anchor.x);
+		int32_t y = quantize(state.anchor.y);
+		int32_t z = quantize(state.anchor.z);
+		int heading = static_cast<int>(std::lround(state.anchor.heading * HEADING_STEPS / (2.0f * 3.14159265f))) & (HEADING_STEPS - 1);
+		int speed = static_cast<int>(std::lround(state.anchor.speed * 10.0f));
+		long long timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(state.anchorWallTime.time_since_epoch()).count();
+
+		// k = keyframe (absolute x/y/z, zone); otherwise dx/dy/dz from the previous update.
+		// h is in 1/256 turns, v in 0.1 yalms per second
+		jsonPayload << "\"seq\":" << state.sequence << ","
+		           << "\"t\":" << timeMs << ",";
+		if (keyframe)
+		{
+			jsonPayload << "\"k\":1,\"zone\":" << state.anchor.zone << ","
+			           << "\"x\":" << x << ",\"y\":" << y << ",\"z\":" << z << ",";
+		}
+		else
+		{
+			jsonPayload << "\"dx\":" << (x - state.sentX) << ",\"dy\":" << (y - state.sentY) << ",\"dz\":" << (z - state.sentZ) << ",";
+		}
+		jsonPayload << "\"h\":" << heading << ",\"v\":" << speed;
+	}
+	jsonPayload << "}";
+
+	// Deltas only make sense in order, so each update gets its own publisher slot
+	g_playerInstance->getChangePublisher().publishOrdered(procId, getPropertyName(), API_ENDPOINT, jsonPayload.str());
+}
@@ -0,0 +1,61 @@
+#include "Player/PropertyRegistry.h"
+#include <iostream>
+
+void PropertyRegistry::bind(PropertyTypeId typeId, const char* name, size_t slot)
+{
+	if (typeId != nullptr)
+	{
+		slotsByType[typeId] = slot;
+	}
+
+	if (internedNames.size() <= slot)
+	{
+		internedNames.resize(slot + 1);
+	}
+	internedNames[slot] = name ? name : "";
+
+	uint32_t nameHash = hashPropertyName(internedNames[slot].c_str());
+	auto it = slotsByName.find(nameHash);
+	if (it != slotsByName.end() && it->second != slot && internedNames[it->second] != internedNames[slot])
+	{
+		std::cout << "[PropertyRegistry] WARNING: name hash collision between '" << internedNames[it->second]
+		          << "' and '" << internedNames[slot] << "'" << std::endl;
+	}
+	slotsByName[nameHash] = slot;
+}
+
+size_t PropertyRegistry::findByType(PropertyTypeId typeId) const
+{
+	auto it = slotsByType.find(typeId);
+	return (it != slotsByType.end()) ? it->second : npos;
+}
+
+size_t PropertyRegistry::findByName(const char* name) const
+{
+	if (!name)
+	{
+		return npos;
+	}
+
+	auto it = slotsByName.find(hashPropertyName(name));
+	if (it == slotsByName.end())
+	{
+		return npos;
+	}
+
+	// Confirm the interned name to guard against hash collisions
+	return (internedNames[it->second] == name) ? it->second : npos;
+}
+
+size_t PropertyRegistry::findByHash(uint32_t nameHash) const
+{
+	auto it = slotsByName.find(nameHash);
+	return (it != slotsByName.end()) ? it->second : npos;
+}
+
+void PropertyRegistry::clear()
+{
+	slotsByType.clear();
+	slotsByName.clear();
+	internedNames.clear();
+}
@@ -0,0 +1,258 @@
+#include "Player/RecastProperty.h"
+#include <iostream>
+#include <sstream>
+
+// Static API endpoint definition
+const std::string RecastProperty::API_ENDPOINT = "http://192.168.5.30:8080/set_recasts";
+
+RecastProperty::RecastProperty()
+{
+}
+
+bool RecastProperty::needsResync(const RecastState &state, std::chrono::steady_clock::time_point now) const
+{
+	if (!state.loaded || state.resyncRequested)
+	{
+		return true;
+	}
+
+	if (now - state.lastRead >= std::chrono::milliseconds(SAFETY_RESYNC_MS))
+	{
+		return true;
+	}
+
+	// A timer that ran out since the last read - confirm it really is ready
+	for (const auto &pair : state.abilities)
+	{
+		if (pair.second <= now)
+			return true;
+	}
+	for (const auto &pair : state.spells)
+	{
+		if (pair.second <= now)
+			return true;
+	}
+	return false;
+}
+
+void RecastProperty::refresh(const PlayerProcessInfo &process)
+{
+	auto now = std::chrono::steady_clock::now();
+	{
+		std::lock_guard<std::mutex> lock(propertyMutex);
+		if (!needsResync(states[process.procId], now))
+		{
+			return; // Timers are counting down locally
+		}
+	}
+
+	uintptr_t abilityAddress = FindDMAAddy(process.hProcess, process.dllBase + abilityRecastOffset, abilityRecastOffsets);
+	uintptr_t spellAddress = FindDMAAddy(process.hProcess, process.dllBase + spellRecastOffset, spellRecastOffsets);
+	if (abilityAddress == 0 || spellAddress == 0)
+	{
+		return;
+	}
+
+	AbilityRecastTable abilityTable;
+	std::vector<uint16_t> spellTimers(SPELL_SLOTS, 0);
+	if (!ReadProcessMemory(process.hProcess, (BYTE *)abilityAddress, &abilityTable, sizeof(abilityTable), nullptr) ||
+	    !ReadProcessMemory(process.hProcess, (BYTE *)spellAddress, spellTimers.data(), spellTimers.size() * sizeof(uint16_t), nullptr))
+	{
+		std::cout << "Failed to read recast timers for process " << process.procId << std::endl;
+		return;
+	}
+
+	auto ticksToDuration = [](uint32_t ticks) {
+		return std::chrono::milliseconds(static_cast<long long>(ticks) * 1000 / TICKS_PER_SECOND);
+	};
+
+	std::map<uint16_t, std::chrono::steady_clock::time_point> abilities;
+	for (size_t slot = 0; slot < ABILITY_SLOTS; slot++)
+	{
+		// Slot 0 is the two-hour (recast ID 0); others are empty when the timer is zero
+		if (abilityTable.timers[slot] == 0)
+			continue;
+		abilities[abilityTable.ids[slot]] = now + ticksToDuration(abilityTable.timers[slot]);
+	}
+
+	std::map<uint16_t, std::chrono::steady_clock::time_point> spells;
+	for (size_t id = 0; id < SPELL_SLOTS; id++)
+	{
+		if (spellTimers[id] != 0)
+			spells[static_cast<uint16_t>(id)] = now + ticksToDuration(spellTimers[id]);
+	}
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	readCount++;
+	RecastState &state = states[process.procId];
+	state.lastRead = now;
+	state.resyncRequested = false;
+	state.loaded = true;
+
+	if (!sameTimers(state.abilities, abilities) || !sameTimers(state.spells, spells))
+	{
+		state.dirty = true;
+		bumpVersion(process.procId);
+	}
+	state.abilities.swap(abilities);
+	state.spells.swap(spells);
+}
+
+bool RecastProperty::sameTimers(const std::map<uint16_t, std::chrono::steady_clock::time_point> &a,
+                                const std::map<uint16_t, std::chrono::steady_clock::time_point> &b)
+{
+	if (a.size() != b.size())
+	{
+		return false;
+	}
+
+	// Re-reading a running timer lands within a tick or two of the local countdown
+	for (auto itA = a.begin(), itB = b.begin(); itA != a.end(); ++itA, ++itB)
+	{
+		if (itA->first != itB->first)
+			return false;
+		auto drift = (itA->second > itB->second) ? itA->second - itB->second : itB->second - itA->second;
+		if (drift >= std::chrono::milliseconds(REPORT_TOLERANCE_MS))
+			return false;
+	}
+	return true;
+}
+
+std::chrono::system_clock::time_point RecastProperty::toWallClock(std::chrono::steady_clock::time_point readyAt)
+{
+	auto remaining = readyAt - std::chrono::steady_clock::now();
+	return std::chrono::system_clock::now() + std::chrono::duration_cast<std::chrono::system_clock::duration>(remaining);
+}
+
+void RecastProperty::requestResync(DWORD procId)
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	states[procId].resyncRequested = true;
+}
+
+std::chrono::milliseconds RecastProperty::getRemaining(DWORD procId, RecastKind kind, uint16_t id) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	if (it == states.end())
+	{
+		return std::chrono::milliseconds(0);
+	}
+
+	const auto &timers = (kind == RecastKind::Ability) ? it->second.abilities : it->second.spells;
+	auto timer = timers.find(id);
+	if (timer == timers.end())
+	{
+		return std::chrono::milliseconds(0);
+	}
+
+	auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(timer->second - std::chrono::steady_clock::now());
+	return (remaining.count() > 0) ? remaining : std::chrono::milliseconds(0);
+}
+
+bool RecastProperty::isReady(DWORD procId, RecastKind kind, uint16_t id) const
+{
+	return getRemaining(procId, kind, id).count() == 0;
+}
+
+std::vector<RecastProperty::RecastEntry> RecastProperty::getActive(DWORD procId, RecastKind kind) const
+{
+	std::vector<RecastEntry> active;
+	auto now = std::chrono::steady_clock::now();
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	if (it == states.end())
+	{
+		return active;
+	}
+
+	const auto &timers = (kind == RecastKind::Ability) ? it->second.abilities : it->second.spells;
+	for (const auto &pair : timers)
+	{
+		if (pair.second > now)
+		{
+			active.push_back(RecastEntry{pair.first, toWallClock(pair.second)});
+		}
+	}
+	return active;
+}
+
+uint64_t RecastProperty::getReadCount() const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	return readCount;
+}
+
+const char *RecastProperty::getPropertyName() const
+{
+	return "Recasts";
+}
+
+void RecastProperty::displayValue(DWORD procId) const
+{
+	std::vector<RecastEntry> abilities = getActive(procId, RecastKind::Ability);
+	std::vector<RecastEntry> spells = getActive(procId, RecastKind::Spell);
+	std::cout << abilities.size() << " abilities, " << spells.size() << " spells on recast";
+}
+
+long long RecastProperty::getNumericValue(DWORD procId) const
+{
+	return static_cast<long long>(getActive(procId, RecastKind::Ability).size() + getActive(procId, RecastKind::Spell).size());
+}
+
+bool RecastProperty::hasChanged(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	return it != states.end() && it->second.dirty;
+}
+
+void RecastProperty::acknowledgeChange(DWORD procId)
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	if (it != states.end())
+	{
+		it->second.dirty = false;
+	}
+}
+
+void RecastProperty::onIdentityChanged(DWORD procId)
+{
+	PlayerProperty::onIdentityChanged(procId);
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	states.erase(procId);
+}
+
+void RecastProperty::reportChange(DWORD procId) const
+{
+	if (!g_playerInstance)
+	{
+		return;
+	}
+
+	auto writeEntries = [](std::ostringstream &out, const std::vector<RecastEntry> &entries) {
+		out << "[";
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			long long readyAtMs = std::chrono::duration_cast<std::chrono::milliseconds>(entries[i].readyAt.time_since_epoch()).count();
+			out << (i > 0 ? "," : "") << "{\"id\":" << entries[i].id << ",\"readyAt\":" << readyAtMs << "}";
+		}
+		out << "]";
+	};
+
+	// Absolute ready-at times (Unix ms); consumers count down on their own clock
+	std::ostringstream jsonPayload;
+	jsonPayload << "{"
+	           << "\"playerName\":\"" << escapeJsonString(g_playerInstance->getPlayerName(procId)) << "\","
+	           << "\"playerId\":" << g_playerInstance->getPlayerId(procId) << ","
+	           << "\"abilities\":";
+	writeEntries(jsonPayload, getActive(procId, RecastKind::Ability));
+	jsonPayload << ",\"spells\":";
+	writeEntries(jsonPayload, getActive(procId, RecastKind::Spell));
+	jsonPayload << "}";
+
+	g_playerInstance->getChangePublisher().publish(procId, getPropertyName(), API_ENDPOINT, jsonPayload.str());
+}
@@ -0,0 +1,209 @@
+#include "Player/StatusEffectProperty.h"
+#include <iostream>
+#include <sstream>
+
+// Static API endpoint definition
+const std::string StatusEffectProperty::API_ENDPOINT = "http://192.168.5.30:8080/set_buffs";
+
+StatusEffectProperty::StatusEffectProperty()
+{
+}
+
+void StatusEffectProperty::refresh(const PlayerProcessInfo &process)
+{
+	// Resolve the table from the cached DLL base (no module snapshot per tick)
+	uintptr_t tableAddress = FindDMAAddy(process.hProcess, process.dllBase + offsetToBaseAddress, offsets);
+	if (tableAddress == 0)
+	{
+		return;
+	}
+
+	// One range read for the whole table
+	BuffTable table;
+	if (!ReadProcessMemory(process.hProcess, (BYTE *)tableAddress, &table, sizeof(table), nullptr))
+	{
+		std::cout << "Failed to read status effects for process " << process.procId << std::endl;
+		return;
+	}
+
+	StatusEffectSet current;
+	std::map<uint16_t, uint32_t> durations;
+	for (size_t slot = 0; slot < MAX_BUFF_SLOTS; slot++)
+	{
+		uint16_t id = table.ids[slot];
+		if (id == EMPTY_SLOT || id >= MAX_STATUS_EFFECT_ID)
+		{
+			continue;
+		}
+
+		current.set(id);
+
+		// The same effect can occupy several slots; keep the longest timer
+		uint32_t &ticks = durations[id];
+		if (table.timers[slot] > ticks)
+		{
+			ticks = table.timers[slot];
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	EffectState &state = effects[process.procId];
+	state.durationTicks.swap(durations);
+	state.readTime = std::chrono::steady_clock::now();
+
+	if (state.current != current)
+	{
+		state.current = current;
+		bumpVersion(process.procId);
+	}
+}
+
+const char *StatusEffectProperty::getPropertyName() const
+{
+	return "Status Effects";
+}
+
+void StatusEffectProperty::displayValue(DWORD procId) const
+{
+	StatusEffectSet set = getEffects(procId);
+	bool first = true;
+	std::cout << "[";
+	set.forEachSetBit([&](size_t id) {
+		std::cout << (first ? "" : ",") << id;
+		first = false;
+	});
+	std::cout << "]";
+}
+
+long long StatusEffectProperty::getNumericValue(DWORD procId) const
+{
+	return static_cast<long long>(getEffects(procId).count());
+}
+
+bool StatusEffectProperty::hasEffect(DWORD procId, uint16_t effectId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = effects.find(procId);
+	return it != effects.end() && it->second.current.test(effectId);
+}
+
+StatusEffectProperty::StatusEffectSet StatusEffectProperty::getEffects(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = effects.find(procId);
+	return (it != effects.end()) ? it->second.current : StatusEffectSet();
+}
+
+std::chrono::milliseconds StatusEffectProperty::getRemaining(DWORD procId, uint16_t effectId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = effects.find(procId);
+	if (it == effects.end())
+	{
+		return std::chrono::milliseconds(0);
+	}
+
+	auto durationIt = it->second.durationTicks.find(effectId);
+	if (durationIt == it->second.durationTicks.end())
+	{
+		return std::chrono::milliseconds(0);
+	}
+
+	auto total = std::chrono::milliseconds(static_cast<long long>(durationIt->second) * 1000 / TIMER_TICKS_PER_SECOND);
+	auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - it->second.readTime);
+	return (elapsed < total) ? total - elapsed : std::chrono::milliseconds(0);
+}
+
+StatusEffectProperty::StatusEffectChange StatusEffectProperty::diff(const StatusEffectSet &before, const StatusEffectSet &after)
+{
+	StatusEffectChange change;
+
+	StatusEffectSet changed;
+	StatusEffectSet::xorOf(before, after, changed);
+	if (!changed.any())
+	{
+		return change;
+	}
+
+	changed.forEachSetBit([&](size_t id) {
+		if (after.test(id))
+			change.added.push_back(static_cast<uint16_t>(id));
+		else
+			change.removed.push_back(static_cast<uint16_t>(id));
+	});
+	return change;
+}
+
+StatusEffectProperty::StatusEffectChange StatusEffectProperty::getPendingChange(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = effects.find(procId);
+	if (it == effects.end())
+	{
+		return StatusEffectChange();
+	}
+	return diff(it->second.reported, it->second.current);
+}
+
+bool StatusEffectProperty::hasChanged(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = effects.find(procId);
+	return it != effects.end() && it->second.current != it->second.reported;
+}
+
+void StatusEffectProperty::acknowledgeChange(DWORD procId)
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = effects.find(procId);
+	if (it != effects.end())
+	{
+		it->second.reported = it->second.current;
+	}
+}
+
+void StatusEffectProperty::onIdentityChanged(DWORD procId)
+{
+	PlayerProperty::onIdentityChanged(procId);
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	effects.erase(procId);
+}
+
+void StatusEffectProperty::reportChange(DWORD procId) const
+{
+	if (!g_playerInstance)
+	{
+		return;
+	}
+
+	StatusEffectChange change = getPendingChange(procId);
+	StatusEffectSet active = getEffects(procId);
+
+	auto writeList = [](std::ostringstream &out, const std::vector<uint16_t> &ids) {
+		out << "[";
+		for (size_t i = 0; i < ids.size(); i++)
+		{
+			out << (i > 0 ? "," : "") << ids[i];
+		}
+		out << "]";
+	};
+
+	std::vector<uint16_t> activeIds;
+	active.forEachSetBit([&](size_t id) { activeIds.push_back(static_cast<uint16_t>(id)); });
+
+	// Carry the full active set so a coalesced (replaced) event cannot desync the server
+	std::ostringstream jsonPayload;
+	jsonPayload << "{"
+	           << "\"playerName\":\"" << escapeJsonString(g_playerInstance->getPlayerName(procId)) << "\","
+	           << "\"playerId\":" << g_playerInstance->getPlayerId(procId) << ",";
+	jsonPayload << "\"added\":";
+	writeList(jsonPayload, change.added);
+	jsonPayload << ",\"removed\":";
+	writeList(jsonPayload, change.removed);
+	jsonPayload << ",\"active\":";
+	writeList(jsonPayload, activeIds);
+	jsonPayload << "}";
+
+	g_playerInstance->getChangePublisher().publish(procId, getPropertyName(), API_ENDPOINT, jsonPayload.str());
+}
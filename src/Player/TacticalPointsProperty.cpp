@@ -1,4 +1,5 @@
 #include "Player/TacticalPointsProperty.h"
+#include "helpers/ffxitext.h"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
@@ -11,9 +12,8 @@ const std::string TacticalPointsProperty::API_ENDPOINT = "http://192.168.5.30:80
 
 TacticalPointsProperty::TacticalPointsProperty()
 {
-	// Set up HTTP client with JSON headers
-	httpClient.setHeader("Content-Type", "application/json")
-	          .setHeader("Accept", "application/json");
+	// Consumers care about weapon skill thresholds, not every melee swing
+	changePolicy = std::make_shared<BandChangePolicy>(std::vector<long long>{1000, 2000, 3000}, 50);
 }
 
 TacticalPointsProperty::~TacticalPointsProperty()
@@ -39,25 +39,15 @@ void TacticalPointsProperty::refresh(const PlayerProcessInfo &process)
 
 	std::lock_guard<std::mutex> lock(propertyMutex);
 
-	// Store previous value for change detection
-	int previousValue = 0;
-	auto it = tacticalPoints.find(process.procId);
-	if (it != tacticalPoints.end())
-	{
-		previousValue = it->second;
-		previousTP[process.procId] = previousValue;
-	}
-
-	// Read TP value from memory
+	// Read TP value from memory (change detection happens in hasChanged via the change policy)
 	int tpValue = 0;
 	if (ReadProcessMemory(process.hProcess, (BYTE *)tpAddress, &tpValue, sizeof(tpValue), nullptr))
 	{
-		tacticalPoints[process.procId] = tpValue;
-
-		// Check if value changed
-		if (previousValue != tpValue)
+		auto it = tacticalPoints.find(process.procId);
+		if (it == tacticalPoints.end() || it->second != tpValue)
 		{
-			changedFlags[process.procId] = true;
+			tacticalPoints[process.procId] = tpValue;
+			bumpVersion(process.procId);
 		}
 	}
 	else
@@ -91,33 +81,33 @@ int TacticalPointsProperty::getTP(DWORD procId) const
 	return (it != tacticalPoints.end()) ? it->second : 0;
 }
 
+long long TacticalPointsProperty::getNumericValue(DWORD procId) const
+{
+	return getTP(procId);
+}
+
 bool TacticalPointsProperty::hasChanged(DWORD procId) const
 {
 	std::lock_guard<std::mutex> lock(propertyMutex);
-	auto it = changedFlags.find(procId);
-	return (it != changedFlags.end()) && it->second;
+	auto it = tacticalPoints.find(procId);
+	return (it != tacticalPoints.end()) && passesChangePolicy(procId, it->second);
 }
 
 void TacticalPointsProperty::acknowledgeChange(DWORD procId)
 {
 	std::lock_guard<std::mutex> lock(propertyMutex);
-	changedFlags[procId] = false;
+	auto it = tacticalPoints.find(procId);
+	if (it != tacticalPoints.end())
+	{
+		previousTP[procId] = it->second;
+		recordReportedValue(procId, it->second);
+	}
 }
 
 std::string TacticalPointsProperty::sanitizePlayerName(const std::string& rawName) const
 {
-	std::string sanitized;
-	sanitized.reserve(rawName.length());
-
-	for (char c : rawName)
-	{
-		// Only include printable ASCII characters (space to tilde: 32-126)
-		// and exclude control characters
-		if (c >= 32 && c <= 126)
-		{
-			sanitized += c;
-		}
-	}
+	// Printable ASCII only, control codes dropped with their parameters
+	std::string sanitized = FFXIText::decode(rawName, FFXIText::Profile::Printable);
 
 	// Trim whitespace from beginning and end
 	size_t start = sanitized.find_first_not_of(" \t");
@@ -138,50 +128,23 @@ std::string TacticalPointsProperty::sanitizePlayerName(const std::string& rawNam
 	return sanitized;
 }
 
-void TacticalPointsProperty::sendTPUpdate(const std::string& playerName, DWORD playerId, int tp) const
+void TacticalPointsProperty::sendTPUpdate(DWORD procId, const std::string& playerName, DWORD playerId, int tp) const
 {
-	try
+	if (!g_playerInstance)
 	{
-		std::cout << "[DEBUG] Attempting to send TP update for player: " << playerName
-		         << ", playerId: " << playerId << ", TP: " << tp << std::endl;
-
-		// Create JSON payload
-		std::ostringstream jsonPayload;
-		jsonPayload << "{"
-		           << "\"playerName\":\"" << playerName << "\","
-		           << "\"playerId\":" << playerId << ","
-		           << "\"tp\":" << tp
-		           << "}";
-
-		std::cout << "[DEBUG] JSON payload: " << jsonPayload.str() << std::endl;
-		std::cout << "[DEBUG] Sending POST to: " << API_ENDPOINT << std::endl;
-
-		// Create a fresh HttpClient for this request to avoid any state issues
-		HttpClient freshClient;
-		freshClient.setHeader("Content-Type", "application/json")
-		          .setHeader("Accept", "application/json")
-		          .setTimeout(10); // 10 second timeout
-
-		// Send POST request
-		HttpClient::HttpResponse response = freshClient.post(API_ENDPOINT, jsonPayload.str());
+		return;
+	}
 
-		std::cout << "[DEBUG] HTTP Response - Status Code: " << response.statusCode << std::endl;
-		std::cout << "[DEBUG] HTTP Response - Body: " << response.body << std::endl;
+	// Create JSON payload
+	std::ostringstream jsonPayload;
+	jsonPayload << "{"
+	           << "\"playerName\":\"" << playerName << "\","
+	           << "\"playerId\":" << playerId << ","
+	           << "\"tp\":" << tp
+	           << "}";
 
-		if (response.isSuccess())
-		{
-			std::cout << "Successfully sent TP update for " << playerName << " (TP: " << tp << ")" << std::endl;
-		}
-		else
-		{
-			std::cout << "Failed to send TP update for " << playerName << ". HTTP " << response.statusCode
-			         << ": " << response.body << std::endl;
-		}
-	}
-	catch (const std::exception& e)
-	{
-		std::cout << "Error sending TP update for " << playerName << ": " << e.what() << std::endl;
-	}
+	// Queue for the publisher thread; a newer TP for this process replaces an unsent one
+	g_playerInstance->getChangePublisher().publish(procId, getPropertyName(), API_ENDPOINT, jsonPayload.str());
 }
 
 void TacticalPointsProperty::reportChange(DWORD procId) const
@@ -194,17 +157,11 @@ void TacticalPointsProperty::reportChange(DWORD procId) const
 	int currentValue = (currentIt != tacticalPoints.end()) ? currentIt->second : 0;
 	int prevValue = (previousIt != previousTP.end()) ? previousIt->second : 0;
 
-	std::cout << "[DEBUG] reportChange called for procId: " << procId << std::endl;
-	std::cout << "[DEBUG] g_playerInstance: " << (g_playerInstance ? "Valid" : "NULL") << std::endl;
-
 	// Get the player name if possible
 	std::string playerName = "Unknown";
 	if (g_playerInstance)
 	{
-		std::string rawName = g_playerInstance->getPlayerName(procId);
-		std::cout << "[DEBUG] Raw player name: '" << rawName << "'" << std::endl;
-		playerName = sanitizePlayerName(rawName);
-		std::cout << "[DEBUG] Sanitized player name: '" << playerName << "'" << std::endl;
+		playerName = sanitizePlayerName(g_playerInstance->getPlayerName(procId));
 	}
 
 	std::cout << "Player [" << playerName << "] (PID: " << procId << ") - TP changed from " << prevValue
@@ -215,9 +172,8 @@ void TacticalPointsProperty::reportChange(DWORD procId) const
 	if (g_playerInstance)
 	{
 		playerId = g_playerInstance->getPlayerId(procId);
-		std::cout << "[DEBUG] Player ID: " << playerId << std::endl;
 	}
 
-	// Send HTTP update to API endpoint
-	sendTPUpdate(playerName, playerId, currentValue);
+	// Queue HTTP update to API endpoint
+	sendTPUpdate(procId, playerName, playerId, currentValue);
 }
@@ -0,0 +1,220 @@
+#include "Player/TargetProperty.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+// Static API endpoint definition
+const std::string TargetProperty::API_ENDPOINT = "http://192.168.5.30:8080/set_target";
+
+TargetProperty::TargetProperty()
+{
+}
+
+void TargetProperty::refresh(const PlayerProcessInfo &process)
+{
+	uintptr_t targetAddress = FindDMAAddy(process.hProcess, process.dllBase + targetOffset, targetOffsets);
+	if (targetAddress == 0)
+	{
+		return;
+	}
+
+	// Fast tier: just the target struct
+	RawTarget raw;
+	if (!ReadProcessMemory(process.hProcess, (BYTE *)targetAddress, &raw, sizeof(raw), nullptr))
+	{
+		return;
+	}
+
+	if (raw.index == 0 || raw.entityPointer == 0)
+	{
+		store(process.procId, TargetInfo(), 0);
+		return;
+	}
+
+	TargetInfo info;
+	bool targetChanged;
+	{
+		std::lock_guard<std::mutex> lock(propertyMutex);
+		const TargetState &state = states[process.procId];
+		targetChanged = raw.index != state.current.index || raw.entityPointer != state.entityPointer;
+		if (!targetChanged)
+		{
+			info = state.current;
+		}
+	}
+
+	// Slow tier: identity, name and claim only when the target changed
+	if (targetChanged)
+	{
+		info.index = raw.index;
+		info.serverId = raw.serverId;
+		if (!readDetails(process.hProcess, raw.entityPointer, info))
+		{
+			return;
+		}
+	}
+
+	// While a target exists: distance and HP% share one small read
+	uint8_t block[EntityLayout::HPP - EntityLayout::DISTANCE + 1];
+	if (!ReadProcessMemory(process.hProcess, (BYTE *)(uintptr_t)(raw.entityPointer + EntityLayout::DISTANCE), block, sizeof(block), nullptr))
+	{
+		return;
+	}
+
+	float distanceSquared;
+	std::memcpy(&distanceSquared, block, sizeof(distanceSquared));
+	info.distance = std::sqrt(distanceSquared);
+	uint8_t hpp = block[EntityLayout::HPP - EntityLayout::DISTANCE];
+
+	// Claim only moves when someone engages, which shows up as HP loss
+	if (!targetChanged && hpp != info.hpp)
+	{
+		ReadProcessMemory(process.hProcess, (BYTE *)(uintptr_t)(raw.entityPointer + EntityLayout::CLAIM_ID), &info.claimId, sizeof(info.claimId), nullptr);
+	}
+	info.hpp = hpp;
+
+	store(process.procId, info, raw.entityPointer);
+}
+
+bool TargetProperty::readDetails(HANDLE hProcess, uint32_t entityPointer, TargetInfo &info)
+{
+	if (!ReadProcessMemory(hProcess, (BYTE *)(uintptr_t)(entityPointer + EntityLayout::CLAIM_ID), &info.claimId, sizeof(info.claimId), nullptr))
+	{
+		std::cout << "Failed to read target entity" << std::endl;
+		return false;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(propertyMutex);
+		auto cached = nameCache.find(info.serverId);
+		if (cached != nameCache.end())
+		{
+			info.name = cached->second;
+			return true;
+		}
+	}
+
+	char name[EntityLayout::NAME_LENGTH + 1] = {0};
+	if (!ReadProcessMemory(hProcess, (BYTE *)(uintptr_t)(entityPointer + EntityLayout::NAME), name, EntityLayout::NAME_LENGTH, nullptr))
+	{
+		return false;
+	}
+	info.name = name;
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	if (nameCache.size() >= MAX_CACHED_NAMES)
+	{
+		nameCache.clear();
+	}
+	nameCache[info.serverId] = info.name;
+	return true;
+}
+
+void TargetProperty::store(DWORD procId, const TargetInfo &info, uint32_t entityPointer)
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	TargetState &state = states[procId];
+	state.current = info;
+	state.entityPointer = entityPointer;
+
+	bool wasPending = state.pending;
+	state.pending = differs(state.current, state.reported);
+	if (state.pending && !wasPending)
+	{
+		bumpVersion(procId);
+	}
+}
+
+bool TargetProperty::differs(const TargetInfo &a, const TargetInfo &b)
+{
+	return a.index != b.index || a.serverId != b.serverId || a.hpp != b.hpp || a.claimId != b.claimId ||
+	       std::fabs(a.distance - b.distance) >= DISTANCE_TOLERANCE;
+}
+
+TargetProperty::TargetInfo TargetProperty::getTarget(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	return (it != states.end()) ? it->second.current : TargetInfo();
+}
+
+const char *TargetProperty::getPropertyName() const
+{
+	return "Target";
+}
+
+void TargetProperty::displayValue(DWORD procId) const
+{
+	TargetInfo target = getTarget(procId);
+	if (target.index == 0)
+	{
+		std::cout << "No target";
+		return;
+	}
+	std::cout << target.name << " (" << static_cast<int>(target.hpp) << "%, " << target.distance << " yalms)";
+}
+
+long long TargetProperty::getNumericValue(DWORD procId) const
+{
+	return getTarget(procId).serverId;
+}
+
+bool TargetProperty::hasChanged(DWORD procId) const
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	return it != states.end() && it->second.pending;
+}
+
+void TargetProperty::acknowledgeChange(DWORD procId)
+{
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	auto it = states.find(procId);
+	if (it != states.end())
+	{
+		it->second.reported = it->second.current;
+		it->second.pending = false;
+	}
+}
+
+void TargetProperty::onIdentityChanged(DWORD procId)
+{
+	PlayerProperty::onIdentityChanged(procId);
+
+	std::lock_guard<std::mutex> lock(propertyMutex);
+	states.erase(procId);
+}
+
+void TargetProperty::reportChange(DWORD procId) const
+{
+	if (!g_playerInstance)
+	{
+		return;
+	}
+
+	TargetInfo target = getTarget(procId);
+
+	std::ostringstream jsonPayload;
+	jsonPayload << "{"
+	           << "\"playerName\":\"" << escapeJsonString(g_playerInstance->getPlayerName(procId)) << "\","
+	           << "\"playerId\":" << g_playerInstance->getPlayerId(procId) << ",";
+	if (target.index == 0)
+	{
+		jsonPayload << "\"target\":null";
+	}
+	else
+	{
+		jsonPayload << "\"target\":{"
+		           << "\"index\":" << target.index << ","
+		           << "\"id\":" << target.serverId << ","
+		           << "\"name\":\"" << escapeJsonString(target.name) << "\","
+		           << "\"hpp\":" << static_cast<int>(target.hpp) << ","
+		           << "\"distance\":" << target.distance << ","
+		           << "\"claimId\":" << target.claimId
+		           << "}";
+	}
+	jsonPayload << "}";
+
+	g_playerInstance->getChangePublisher().publish(procId, getPropertyName(), API_ENDPOINT, jsonPayload.str());
+}
@@ -1,17 +1,87 @@
 #include "helpers/chatlogmonitor.h"
+#include "helpers/ffxitext.h"
+#include "Player/ChatParser.h"
 #include <iostream>
 #include <sstream>
 #include <chrono>
+#include <cstring>
 #include <filesystem>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
 #include <Windows.h>
 #include <ShlObj.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace fs = std::filesystem;
 
+namespace
+{
+    // New bytes are read this much at a time
+    const size_t READ_BLOCK_SIZE = 64 * 1024;
+
+    // Look at the file's size this often even without a notification; NTFS
+    // reports size changes of a file another process keeps open late
+    const int POLL_INTERVAL_MS = 100;
+
+    // Without a directory watch, look for a new session log this often
+    const int RESCAN_INTERVAL_MS = 1000;
+
+    struct LogFile {
+        fs::path path;
+        fs::file_time_type lastWrite;
+    };
+
+    // Every *.log in the directory
+    std::vector<LogFile> ListLogs(const fs::path& directory, std::error_code& error)
+    {
+        std::vector<LogFile> logs;
+        for (fs::directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+        {
+            std::error_code entryError;
+            if (it->is_regular_file(entryError) && it->path().extension() == ".log")
+            {
+                fs::file_time_type lastWrite = it->last_write_time(entryError);
+                if (!entryError)
+                {
+                    logs.push_back({it->path(), lastWrite});
+                }
+            }
+        }
+        return logs;
+    }
+}
+
+#ifdef _WIN32
+struct ChatLogMonitor::Tail {
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE directory = INVALID_HANDLE_VALUE;
+    HANDLE changeEvent = nullptr;
+    HANDLE stopEvent = nullptr;
+    OVERLAPPED overlapped = {};
+    bool watchPending = false;
+    DWORD notifications[1024];  // FILE_NOTIFY_INFORMATION records, DWORD aligned
+};
+#else
+struct ChatLogMonitor::Tail {
+    int file = -1;
+    int inotify = -1;
+    int stopPipe[2] = {-1, -1};
+    alignas(struct inotify_event) char events[4096];
+};
+#endif
+
 ChatLogMonitor::ChatLogMonitor()
     : shouldStop(false)
     , isActive(false)
-    , lastPosition(0)
+    , tail(std::make_unique<Tail>())
 {
 }
 
@@ -25,6 +95,7 @@ bool ChatLogMonitor::FindLogFile(const std::string& playerName)
     // Try multiple possible locations for the log directory
     std::vector<fs::path> possibleDirs;
 
+#ifdef _WIN32
     // Get My Documents path
     char documentsPath[MAX_PATH];
     if (SUCCEEDED(SHGetFolderPathA(NULL, CSIDL_PERSONAL, NULL, 0, documentsPath)))
@@ -37,6 +108,7 @@ bool ChatLogMonitor::FindLogFile(const std::string& playerName)
     {
         possibleDirs.push_back(fs::path(documentsPath) / "PlayOnline" / "PolLog");
     }
+#endif
 
     // Try user profile directly
     char* userProfile = getenv("USERPROFILE");
@@ -79,34 +151,28 @@ bool ChatLogMonitor::FindLogFile(const std::string& playerName)
 
     // Find log files matching pattern: YYYY-MM-DD_HH.MM.SS_<servername>.log
     // We'll look for the most recent file
-    fs::path mostRecentLog;
-    std::time_t mostRecentTime = 0;
+    std::error_code error;
+    std::vector<LogFile> logs = ListLogs(logDir, error);
+    if (error)
+    {
+        std::cerr << "[ChatLog] Error scanning log directory: " << error.message() << std::endl;
+        return false;
+    }
 
-    try
+    // Logs already here belong to earlier sessions (or other clients); only one
+    // created after this point is ever switched to
+    fs::path mostRecentLog;
+    fs::file_time_type mostRecentTime = fs::file_time_type::min();
+    knownLogs.clear();
+    for (const LogFile& log : logs)
     {
-        for (const auto& entry : fs::directory_iterator(logDir))
+        knownLogs.insert(log.path.string());
+        if (mostRecentLog.empty() || log.lastWrite > mostRecentTime)
         {
-            if (entry.is_regular_file() && entry.path().extension() == ".log")
-            {
-                auto lastWrite = fs::last_write_time(entry);
-                auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
-                    lastWrite - fs::file_time_type::clock::now() + std::chrono::system_clock::now()
-                );
-                std::time_t cftime = std::chrono::system_clock::to_time_t(sctp);
-
-                if (cftime > mostRecentTime)
-                {
-                    mostRecentTime = cftime;
-                    mostRecentLog = entry.path();
-                }
-            }
+            mostRecentTime = log.lastWrite;
+            mostRecentLog = log.path;
         }
     }
-    catch (const fs::filesystem_error& e)
-    {
-        std::cerr << "[ChatLog] Error scanning log directory: " << e.what() << std::endl;
-        return false;
-    }
 
     if (mostRecentLog.empty())
     {
@@ -115,21 +181,162 @@ bool ChatLogMonitor::FindLogFile(const std::string& playerName)
         return false;
     }
 
-    logFilePath = mostRecentLog.string();
-    std::cout << "[ChatLog] Monitoring log file: " << logFilePath << std::endl;
+    logDirectory = logDir.string();
+
+    // Start from the end of the file so only new lines are read
+    return OpenLogFile(mostRecentLog.string(), true);
+}
 
-    // Seek to end of file to only read new lines
-    std::ifstream file(logFilePath, std::ios::ate);
-    if (file.is_open())
+bool ChatLogMonitor::OpenLogFile(const std::string& path, bool fromEnd)
+{
+#ifdef _WIN32
+    // Share everything so the client can keep writing (and later delete) the log
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
     {
-        lastPosition = file.tellg();
-        file.close();
-        std::cout << "[ChatLog] Starting from end of file (position: " << lastPosition << ")" << std::endl;
+        std::cerr << "[ChatLog] Failed to open log file: " << path << std::endl;
+        return false;
     }
+    if (fromEnd)
+    {
+        LARGE_INTEGER zero = {};
+        SetFilePointerEx(file, zero, nullptr, FILE_END);
+    }
+    CloseLogFile();
+    tail->file = file;
+#else
+    int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0)
+    {
+        std::cerr << "[ChatLog] Failed to open log file: " << path << std::endl;
+        return false;
+    }
+    if (fromEnd)
+    {
+        lseek(file, 0, SEEK_END);
+    }
+    CloseLogFile();
+    tail->file = file;
+#endif
+
+    logFilePath = path;
+    pending.clear();
+    std::cout << "[ChatLog] Monitoring log file: " << logFilePath
+              << (fromEnd ? " (from end of file)" : " (new session)") << std::endl;
+    return true;
+}
 
+void ChatLogMonitor::CloseLogFile()
+{
+#ifdef _WIN32
+    if (tail->file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(tail->file);
+        tail->file = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (tail->file >= 0)
+    {
+        ::close(tail->file);
+        tail->file = -1;
+    }
+#endif
+}
+
+bool ChatLogMonitor::StartWatching()
+{
+#ifdef _WIN32
+    tail->stopEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    tail->changeEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (!tail->stopEvent || !tail->changeEvent)
+    {
+        StopWatching();
+        return false;
+    }
+
+    tail->directory = CreateFileA(logDirectory.c_str(), FILE_LIST_DIRECTORY,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                  FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    bool watching = (tail->directory != INVALID_HANDLE_VALUE);
+#else
+    if (pipe(tail->stopPipe) != 0)
+    {
+        tail->stopPipe[0] = tail->stopPipe[1] = -1;
+        return false;
+    }
+
+    tail->inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    bool watching = tail->inotify >= 0 &&
+                    inotify_add_watch(tail->inotify, logDirectory.c_str(), IN_MODIFY | IN_CREATE | IN_MOVED_TO) >= 0;
+    if (!watching && tail->inotify >= 0)
+    {
+        // An inotify descriptor without a watch would never wake us; poll instead
+        ::close(tail->inotify);
+        tail->inotify = -1;
+    }
+#endif
+
+    if (!watching)
+    {
+        std::cerr << "[ChatLog] Cannot watch " << logDirectory << "; checking for new logs every "
+                  << RESCAN_INTERVAL_MS << " ms instead" << std::endl;
+    }
     return true;
 }
 
+void ChatLogMonitor::StopWatching()
+{
+#ifdef _WIN32
+    if (tail->watchPending)
+    {
+        // The notification buffer must stay alive until the cancelled read completes
+        DWORD bytes = 0;
+        CancelIoEx(tail->directory, &tail->overlapped);
+        GetOverlappedResult(tail->directory, &tail->overlapped, &bytes, TRUE);
+        tail->watchPending = false;
+    }
+    if (tail->directory != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(tail->directory);
+        tail->directory = INVALID_HANDLE_VALUE;
+    }
+    for (HANDLE* handle : {&tail->changeEvent, &tail->stopEvent})
+    {
+        if (*handle)
+        {
+            CloseHandle(*handle);
+            *handle = nullptr;
+        }
+    }
+#else
+    for (int* descriptor : {&tail->inotify, &tail->stopPipe[0], &tail->stopPipe[1]})
+    {
+        if (*descriptor >= 0)
+        {
+            ::close(*descriptor);
+            *descriptor = -1;
+        }
+    }
+#endif
+}
+
+void ChatLogMonitor::SignalStop()
+{
+#ifdef _WIN32
+    if (tail->stopEvent)
+    {
+        SetEvent(tail->stopEvent);
+    }
+#else
+    if (tail->stopPipe[1] >= 0)
+    {
+        char wake = 1;
+        (void)!write(tail->stopPipe[1], &wake, 1);
+    }
+#endif
+}
+
 bool ChatLogMonitor::StartMonitoring(const std::string& playerName, ChatCallback callback)
 {
     if (isActive)
@@ -146,6 +353,13 @@ bool ChatLogMonitor::StartMonitoring(const std::string& playerName, ChatCallback
         return false;
     }
 
+    if (!StartWatching())
+    {
+        std::cerr << "[ChatLog] Failed to set up change notifications" << std::endl;
+        CloseLogFile();
+        return false;
+    }
+
     shouldStop = false;
     isActive = true;
 
@@ -164,12 +378,15 @@ void ChatLogMonitor::StopMonitoring()
 
     std::cout << "[ChatLog] Stopping monitoring..." << std::endl;
     shouldStop = true;
+    SignalStop();
 
     if (monitorThread.joinable())
     {
         monitorThread.join();
     }
 
+    StopWatching();
+    CloseLogFile();
     isActive = false;
     std::cout << "[ChatLog] Monitoring stopped" << std::endl;
 }
@@ -179,128 +396,269 @@ bool ChatLogMonitor::IsMonitoring() const
     return isActive;
 }
 
-ChatMessageType ChatLogMonitor::ExtractChatType(const std::string& line)
+ChatMessage ChatLogMonitor::ParseLogLine(std::string_view line)
 {
-    // FFXI log format examples:
-    // [HH:MM:SS] PlayerName : Message text
-    // [HH:MM:SS] PlayerName >> Message text (tell)
-    // [HH:MM:SS] (PlayerName) Message text (party)
-    // [HH:MM:SS] <PlayerName> Message text (linkshell)
-    // [HH:MM:SS] PlayerName says: Message text (say - explicit)
+    // FFXI log lines carry a "[HH:MM:SS] " prefix in front of the chat text
+    std::string_view content = line;
+    if (!content.empty() && content.front() == '[')
+    {
+        size_t bracketEnd = content.find(']');
+        if (bracketEnd != std::string_view::npos)
+        {
+            content.remove_prefix(bracketEnd + 1);
+        }
+    }
 
-    if (line.find(" >> ") != std::string::npos)
-        return ChatMessageType::Tell;
+    cleanLine.clear();
+    FFXIText::decode(content, FFXIText::Profile::Chat, cleanLine);
 
-    if (line.find('(') != std::string::npos && line.find(')') != std::string::npos)
-        return ChatMessageType::Party;
+    // Timestamp is the current time since the log doesn't have a full one
+    return ChatParser::parse(cleanLine).materialize();
+}
+
+void ChatLogMonitor::ReadNewLines()
+{
+#ifdef _WIN32
+    if (tail->file == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
 
-    if (line.find('<') != std::string::npos && line.find('>') != std::string::npos)
-        return ChatMessageType::Linkshell;
+    // A log that shrank was rewritten; start it over
+    LARGE_INTEGER zero = {};
+    LARGE_INTEGER position = {};
+    LARGE_INTEGER fileSize = {};
+    if (SetFilePointerEx(tail->file, zero, &position, FILE_CURRENT) && GetFileSizeEx(tail->file, &fileSize))
+    {
+        if (fileSize.QuadPart == position.QuadPart)
+        {
+            return; // Nothing new; the common case on every poll
+        }
+        if (fileSize.QuadPart < position.QuadPart)
+        {
+            SetFilePointerEx(tail->file, zero, nullptr, FILE_BEGIN);
+            pending.clear();
+        }
+    }
+#else
+    if (tail->file < 0)
+    {
+        return;
+    }
+
+    // A log that shrank was rewritten; start it over
+    struct stat fileStat;
+    off_t position = lseek(tail->file, 0, SEEK_CUR);
+    if (fstat(tail->file, &fileStat) == 0 && position >= 0)
+    {
+        if (fileStat.st_size == position)
+        {
+            return; // Nothing new; the common case on every poll
+        }
+        if (fileStat.st_size < position)
+        {
+            lseek(tail->file, 0, SEEK_SET);
+            pending.clear();
+        }
+    }
+#endif
 
-    if (line.find(" shouts:") != std::string::npos || line.find(" shouts :") != std::string::npos)
-        return ChatMessageType::Shout;
+    while (true)
+    {
+        // Read a block after whatever partial line is left over
+        size_t carried = pending.size();
+        pending.resize(carried + READ_BLOCK_SIZE);
 
-    if (line.find(" yells:") != std::string::npos || line.find(" yells :") != std::string::npos)
-        return ChatMessageType::Yell;
+#ifdef _WIN32
+        DWORD bytesRead = 0;
+        if (!ReadFile(tail->file, &pending[carried], static_cast<DWORD>(READ_BLOCK_SIZE), &bytesRead, nullptr))
+        {
+            bytesRead = 0;
+        }
+        size_t got = bytesRead;
+#else
+        ssize_t result = ::read(tail->file, &pending[carried], READ_BLOCK_SIZE);
+        size_t got = result > 0 ? static_cast<size_t>(result) : 0;
+#endif
+        pending.resize(carried + got);
+        if (got == 0)
+        {
+            return;
+        }
 
-    // Check for emote patterns
-    if (line.find(" uses ") != std::string::npos ||
-        line.find(" starts ") != std::string::npos ||
-        line.find(" waves") != std::string::npos)
-        return ChatMessageType::Emote;
+        // Split on newlines; the carried bytes hold none, so the scan starts at the new block.
+        // 0x0A is never a Shift-JIS trail byte, so a line never splits a character
+        const char* data = pending.data();
+        const char* end = data + pending.size();
+        const char* lineStart = data;
+        const char* scan = data + carried;
+        while (const void* found = std::memchr(scan, '\n', static_cast<size_t>(end - scan)))
+        {
+            const char* newline = static_cast<const char*>(found);
+            DispatchLine(std::string_view(lineStart, static_cast<size_t>(newline - lineStart)));
+            lineStart = newline + 1;
+            scan = lineStart;
+        }
+        pending.erase(0, static_cast<size_t>(lineStart - data));
 
-    // Default to Say for standard format
-    return ChatMessageType::Say;
+        if (got < READ_BLOCK_SIZE)
+        {
+            return;
+        }
+    }
 }
 
-ChatMessage ChatLogMonitor::ParseLogLine(const std::string& line)
+bool ChatLogMonitor::WaitForChange(std::string& newLogPath)
 {
-    ChatMessage msg;
-    msg.type = ExtractChatType(line);
-    msg.timestamp = std::time(nullptr); // Use current time since log doesn't have full timestamp
+    // Set when a created log could have been missed: the notification queue
+    // overflowed, or there is no watch and the rescan interval has passed
+    bool rescan = false;
 
-    // Remove timestamp and leading whitespace
-    std::string content = line;
-    size_t bracketEnd = content.find(']');
-    if (bracketEnd != std::string::npos)
+#ifdef _WIN32
+    if (!tail->watchPending && tail->directory != INVALID_HANDLE_VALUE)
     {
-        content = content.substr(bracketEnd + 1);
+        ResetEvent(tail->changeEvent);
+        tail->overlapped = {};
+        tail->overlapped.hEvent = tail->changeEvent;
+        tail->watchPending = ReadDirectoryChangesW(tail->directory, tail->notifications, sizeof(tail->notifications), FALSE,
+                                                   FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE,
+                                                   nullptr, &tail->overlapped, nullptr) != FALSE;
     }
 
-    // Trim leading whitespace
-    content.erase(0, content.find_first_not_of(" \t"));
+    bool watching = tail->watchPending;
+    HANDLE handles[2] = {tail->stopEvent, tail->changeEvent};
+    DWORD result = WaitForMultipleObjects(tail->watchPending ? 2 : 1, handles, FALSE, POLL_INTERVAL_MS);
+    if (result == WAIT_OBJECT_0)
+    {
+        return false;
+    }
 
-    // Parse based on chat type
-    switch (msg.type)
+    if (result == WAIT_OBJECT_0 + 1)
     {
-        case ChatMessageType::Tell:
+        tail->watchPending = false;
+        DWORD bytes = 0;
+        // Zero bytes (or ERROR_NOTIFY_ENUM_DIR) means the buffer overflowed and the changes were lost
+        rescan = true;
+        if (GetOverlappedResult(tail->directory, &tail->overlapped, &bytes, FALSE) && bytes > 0)
         {
-            // Format: PlayerName >> Message
-            size_t arrowPos = content.find(" >> ");
-            if (arrowPos != std::string::npos)
+            rescan = false;
+
+            // Only file creation matters here; writes are picked up by the read that follows
+            const BYTE* record = reinterpret_cast<const BYTE*>(tail->notifications);
+            while (true)
             {
-                msg.sender = content.substr(0, arrowPos);
-                msg.message = content.substr(arrowPos + 4);
+                const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(record);
+                if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+                {
+                    NoteCreatedLog(fs::path(logDirectory) / std::wstring(info->FileName, info->FileNameLength / sizeof(WCHAR)),
+                                   newLogPath);
+                }
+                if (info->NextEntryOffset == 0)
+                {
+                    break;
+                }
+                record += info->NextEntryOffset;
             }
-            break;
         }
+    }
+#else
+    bool watching = tail->inotify >= 0;
+    struct pollfd waits[2] = {{tail->stopPipe[0], POLLIN, 0}, {tail->inotify, POLLIN, 0}};
+    int ready = poll(waits, tail->inotify >= 0 ? 2 : 1, POLL_INTERVAL_MS);
+    if (ready > 0 && (waits[0].revents & POLLIN))
+    {
+        return false;
+    }
 
-        case ChatMessageType::Party:
+    if (ready > 0 && (waits[1].revents & POLLIN))
+    {
+        // Only file creation matters here; writes are picked up by the read that follows
+        ssize_t length;
+        while ((length = ::read(tail->inotify, tail->events, sizeof(tail->events))) > 0)
         {
-            // Format: (PlayerName) Message
-            size_t parenEnd = content.find(')');
-            if (parenEnd != std::string::npos)
+            for (const char* record = tail->events; record < tail->events + length;)
             {
-                msg.sender = content.substr(1, parenEnd - 1);
-                msg.message = content.substr(parenEnd + 1);
-                msg.message.erase(0, msg.message.find_first_not_of(" \t"));
+                const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(record);
+                if (event->mask & IN_Q_OVERFLOW)
+                {
+                    rescan = true;
+                }
+                if ((event->mask & (IN_CREATE | IN_MOVED_TO)) && event->len > 0)
+                {
+                    NoteCreatedLog(fs::path(logDirectory) / event->name, newLogPath);
+                }
+                record += sizeof(struct inotify_event) + event->len;
             }
-            break;
         }
+    }
+#endif
+
+    // A timeout with a working watch only means nothing was created; the caller
+    // still checks the file size
+    auto now = std::chrono::steady_clock::now();
+    if (!watching && now - lastRescan >= std::chrono::milliseconds(RESCAN_INTERVAL_MS))
+    {
+        rescan = true;
+    }
 
-        case ChatMessageType::Linkshell:
+    if (rescan)
+    {
+        lastRescan = now;
+        std::error_code error;
+        fs::path newest;
+        fs::file_time_type newestTime = fs::file_time_type::min();
+        for (const LogFile& log : ListLogs(logDirectory, error))
         {
-            // Format: <PlayerName> Message
-            size_t bracketEnd = content.find('>');
-            if (bracketEnd != std::string::npos)
+            // Only a log that wasn't there before counts as a new session
+            if (knownLogs.insert(log.path.string()).second && (newest.empty() || log.lastWrite > newestTime))
             {
-                msg.sender = content.substr(1, bracketEnd - 1);
-                msg.message = content.substr(bracketEnd + 1);
-                msg.message.erase(0, msg.message.find_first_not_of(" \t"));
+                newestTime = log.lastWrite;
+                newest = log.path;
             }
-            break;
         }
-
-        default:
+        if (!newest.empty())
         {
-            // Format: PlayerName : Message or PlayerName says: Message
-            size_t colonPos = content.find(':');
-            if (colonPos != std::string::npos)
-            {
-                msg.sender = content.substr(0, colonPos);
+            newLogPath = newest.string();
+        }
+    }
 
-                // Remove trailing "says", "shouts", "yells" from sender
-                size_t spacePos = msg.sender.find_last_of(' ');
-                if (spacePos != std::string::npos)
-                {
-                    std::string verb = msg.sender.substr(spacePos + 1);
-                    if (verb == "says" || verb == "shouts" || verb == "yells")
-                    {
-                        msg.sender = msg.sender.substr(0, spacePos);
-                    }
-                }
+    return !shouldStop;
+}
 
-                // Trim sender
-                msg.sender.erase(msg.sender.find_last_not_of(" \t") + 1);
+void ChatLogMonitor::NoteCreatedLog(const fs::path& path, std::string& newLogPath)
+{
+    // A log seen before (including every one already followed) is never switched back to
+    if (path.extension() == ".log" && knownLogs.insert(path.string()).second)
+    {
+        newLogPath = path.string();
+    }
+}
 
-                msg.message = content.substr(colonPos + 1);
-                msg.message.erase(0, msg.message.find_first_not_of(" \t"));
-            }
-            break;
-        }
+void ChatLogMonitor::DispatchLine(std::string_view line)
+{
+    if (!line.empty() && line.back() == '\r')
+    {
+        line.remove_suffix(1);
     }
+    if (line.empty())
+    {
+        return;
+    }
+
+    ChatMessage msg = ParseLogLine(line);
 
-    return msg;
+    // Only process if we got valid sender and message
+    if (!msg.sender.empty() && !msg.message.empty())
+    {
+        std::cout << "[ChatLog] " << msg.sender << " ("
+                  << static_cast<int>(msg.type) << "): "
+                  << msg.message << std::endl;
+
+        if (callback)
+        {
+            callback(msg);
+        }
+    }
 }
 
 void ChatLogMonitor::MonitorThreadFunc()
@@ -311,50 +669,25 @@ void ChatLogMonitor::MonitorThreadFunc()
     {
         try
         {
-            std::ifstream file(logFilePath);
-            if (!file.is_open())
+            ReadNewLines();
+
+            std::string newLogPath;
+            if (!WaitForChange(newLogPath))
             {
-                std::cerr << "[ChatLog] Failed to open log file: " << logFilePath << std::endl;
-                std::this_thread::sleep_for(std::chrono::seconds(1));
-                continue;
+                break;
             }
 
-            // Seek to last read position
-            file.seekg(lastPosition);
-
-            std::string line;
-            while (std::getline(file, line))
+            // A new session log: finish the old one, then follow the new one from its start
+            if (!newLogPath.empty() && newLogPath != logFilePath)
             {
-                if (!line.empty())
-                {
-                    ChatMessage msg = ParseLogLine(line);
-
-                    // Only process if we got valid sender and message
-                    if (!msg.sender.empty() && !msg.message.empty())
-                    {
-                        std::cout << "[ChatLog] " << msg.sender << " ("
-                                  << static_cast<int>(msg.type) << "): "
-                                  << msg.message << std::endl;
-
-                        if (callback)
-                        {
-                            callback(msg);
-                        }
-                    }
-                }
+                ReadNewLines();
+                OpenLogFile(newLogPath, false);
             }
-
-            // Update last position
-            lastPosition = file.tellg();
-            file.close();
         }
         catch (const std::exception& e)
         {
             std::cerr << "[ChatLog] Error in monitor thread: " << e.what() << std::endl;
         }
-
-        // Sleep before next poll
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
 
     std::cout << "[ChatLog] Monitor thread ended" << std::endl;
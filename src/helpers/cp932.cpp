@@ -0,0 +1,175 @@
+#include "helpers/cp932.h"
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CP932_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CP932_SSE2 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace CP932 {
+
+namespace {
+
+inline unsigned countTrailingZeros(uint32_t mask)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return static_cast<unsigned>(index);
+#else
+	return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// Length of the ASCII run at the start of a 16/32-byte block, or the block size.
+// ASCII is the same in both encodings, so the run is copied as it is.
+#if defined(CP932_AVX2)
+const size_t BLOCK = 32;
+
+inline size_t asciiRun(const char *src)
+{
+	__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+	uint32_t high = static_cast<uint32_t>(_mm256_movemask_epi8(v));
+	return high ? countTrailingZeros(high) : BLOCK;
+}
+
+inline void copyBlock(char *dst, const char *src)
+{
+	_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src)));
+}
+#elif defined(CP932_SSE2)
+const size_t BLOCK = 16;
+
+inline size_t asciiRun(const char *src)
+{
+	__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+	uint32_t high = static_cast<uint32_t>(_mm_movemask_epi8(v));
+	return high ? countTrailingZeros(high) : BLOCK;
+}
+
+inline void copyBlock(char *dst, const char *src)
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+}
+#else
+const size_t BLOCK = 8;
+
+inline size_t asciiRun(const char *src)
+{
+	size_t run = 0;
+	while (run < BLOCK && static_cast<unsigned char>(src[run]) < 0x80)
+		run++;
+	return run;
+}
+
+inline void copyBlock(char *dst, const char *src)
+{
+	std::memcpy(dst, src, BLOCK);
+}
+#endif
+
+// Encode a lead/trail pair. An unmapped pair whose trail is ASCII only
+// consumes the lead, so the ASCII byte is not swallowed; returns whether
+// the trail was consumed.
+inline bool writePair(uint8_t lead, uint8_t trail, char *&dst)
+{
+	uint32_t codePoint = toCodePoint(lead, trail);
+	if (codePoint != 0)
+	{
+		dst += encodeUtf8(codePoint, dst);
+		return true;
+	}
+	dst += encodeUtf8(REPLACEMENT, dst);
+	return trail >= 0x80;
+}
+
+} // namespace
+
+void Decoder::decode(std::string_view input, std::string &out)
+{
+	if (input.empty())
+		return;
+
+	// Every input byte becomes at most 3 output bytes (plus a held lead byte);
+	// the slack lets block stores overrun the logical end
+	const size_t start = out.size();
+	out.resize(start + input.size() * 3 + 3 + BLOCK);
+	char *dst = &out[start];
+
+	const char *src = input.data();
+	const char *end = src + input.size();
+
+	if (pendingLead != 0)
+	{
+		if (writePair(pendingLead, static_cast<uint8_t>(*src), dst))
+			src++;
+		pendingLead = 0;
+	}
+
+	while (src < end)
+	{
+		// Fast path: copy ASCII a block at a time
+		while (end - src >= static_cast<ptrdiff_t>(BLOCK))
+		{
+			size_t run = asciiRun(src);
+			copyBlock(dst, src);
+			dst += run;
+			src += run;
+			if (run < BLOCK)
+				break;
+		}
+		if (src >= end)
+			break;
+
+		uint8_t byte = static_cast<uint8_t>(*src++);
+		if (byte < 0x80)
+		{
+			*dst++ = static_cast<char>(byte);
+			continue;
+		}
+		if (isLeadByte(byte))
+		{
+			if (src == end)
+			{
+				pendingLead = byte;
+				break;
+			}
+			if (writePair(byte, static_cast<uint8_t>(*src), dst))
+				src++;
+			continue;
+		}
+
+		uint32_t codePoint = toCodePoint(byte);
+		dst += encodeUtf8(codePoint != 0 ? codePoint : REPLACEMENT, dst);
+	}
+
+	out.resize(static_cast<size_t>(dst - out.data()));
+}
+
+void Decoder::finish(std::string &out)
+{
+	if (pendingLead != 0)
+	{
+		char buffer[3];
+		out.append(buffer, encodeUtf8(REPLACEMENT, buffer));
+		pendingLead = 0;
+	}
+}
+
+std::string toUtf8(std::string_view input)
+{
+	std::string out;
+	Decoder decoder;
+	decoder.decode(input, out);
+	decoder.finish(out);
+	return out;
+}
+
+} // namespace CP932
@@ -0,0 +1,317 @@
+#include "helpers/ffxitext.h"
+#include "helpers/cp932.h"
+#include "helpers/resourcetable.h"
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FFXITEXT_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FFXITEXT_SSE2 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace FFXIText {
+
+namespace {
+
+using RuleTable = std::array<ByteRule, 256>;
+
+void setRange(RuleTable &table, int first, int last, Action action, uint8_t params)
+{
+	for (int b = first; b <= last; b++)
+	{
+		table[b] = ByteRule{action, params};
+	}
+}
+
+RuleTable buildTable(Profile profile)
+{
+	RuleTable table;
+
+	// Control codes (shared by every profile)
+	setRange(table, 0x00, 0x1D, Action::Drop, 0);
+	setRange(table, 0x1E, 0x1F, Action::Drop, 1);
+	setRange(table, 0x20, 0x7E, Action::Keep, 0);
+	setRange(table, 0x7F, 0x7F, Action::Drop, 1);
+
+	// High bytes: Shift-JIS lead bytes own the byte after them
+	Action text = Action::Drop;
+	if (profile == Profile::Chat)
+		text = Action::Keep;
+	else if (profile == Profile::Json)
+		text = Action::Transcode;
+	setRange(table, 0x80, 0x80, Action::Drop, 0);
+	setRange(table, 0x81, 0x9F, text, 1);
+	setRange(table, 0xA0, 0xA0, Action::Drop, 0);
+	setRange(table, 0xA1, 0xDF, text, 0);  // Half-width katakana
+	setRange(table, 0xE0, 0xFC, text, 1);
+	setRange(table, 0xFD, 0xFD, Action::Phrase, 0);
+	setRange(table, 0xFE, 0xFF, Action::Drop, 0);
+
+	if (profile == Profile::Json)
+	{
+		table['"'] = ByteRule{Action::Escape, 0};
+		table['\\'] = ByteRule{Action::Escape, 0};
+	}
+	return table;
+}
+
+const RuleTable printableRules = buildTable(Profile::Printable);
+const RuleTable chatRules = buildTable(Profile::Chat);
+const RuleTable jsonRules = buildTable(Profile::Json);
+
+inline unsigned countTrailingZeros(uint32_t mask)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return static_cast<unsigned>(index);
+#else
+	return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// Length of the plain-ASCII run at the start of a 16/32-byte block, or the block size
+#if defined(FFXITEXT_AVX2)
+const size_t BLOCK = 32;
+
+inline size_t plainRun(const char *src, bool json)
+{
+	__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+	__m256i plain = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(0x1F)),
+	                                 _mm256_cmpgt_epi8(_mm256_set1_epi8(0x7F), v));
+	if (json)
+	{
+		__m256i quoted = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')),
+		                                 _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+		plain = _mm256_andnot_si256(quoted, plain);
+	}
+	uint32_t special = ~static_cast<uint32_t>(_mm256_movemask_epi8(plain));
+	return special ? countTrailingZeros(special) : BLOCK;
+}
+
+inline void copyBlock(char *dst, const char *src)
+{
+	_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src)));
+}
+#elif defined(FFXITEXT_SSE2)
+const size_t BLOCK = 16;
+
+inline size_t plainRun(const char *src, bool json)
+{
+	// Signed compares: bytes >= 0x80 are negative and fail the lower bound
+	__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+	__m128i plain = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(0x1F)),
+	                              _mm_cmplt_epi8(v, _mm_set1_epi8(0x7F)));
+	if (json)
+	{
+		__m128i quoted = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+		                              _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+		plain = _mm_andnot_si128(quoted, plain);
+	}
+	uint32_t special = ~static_cast<uint32_t>(_mm_movemask_epi8(plain)) & 0xFFFF;
+	return special ? countTrailingZeros(special) : BLOCK;
+}
+
+inline void copyBlock(char *dst, const char *src)
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+}
+#else
+const size_t BLOCK = 8;
+
+inline size_t plainRun(const char *src, bool json)
+{
+	size_t run = 0;
+	while (run < BLOCK)
+	{
+		unsigned char c = static_cast<unsigned char>(src[run]);
+		if (c < 0x20 || c > 0x7E || (json && (c == '"' || c == '\\')))
+			break;
+		run++;
+	}
+	return run;
+}
+
+inline void copyBlock(char *dst, const char *src)
+{
+	std::memcpy(dst, src, BLOCK);
+}
+#endif
+
+// Auto-translate token: 0xFD, type, language, category, index, 0xFD.
+// The type values are the ones the client uses for dictionary phrases
+// and item links.
+const size_t TOKEN_LENGTH = 6;
+const uint8_t TOKEN_PHRASE = 0x02;
+const uint8_t TOKEN_ITEM = 0x07;
+
+std::atomic<const ResourceTables *> phraseTable{nullptr};
+
+std::string_view resolveToken(const char *token)
+{
+	const ResourceTables *tables = phraseTable.load(std::memory_order_acquire);
+	if (!tables)
+		return std::string_view();
+
+	uint32_t id = (static_cast<uint32_t>(static_cast<uint8_t>(token[3])) << 8) | static_cast<uint8_t>(token[4]);
+	switch (static_cast<uint8_t>(token[1]))
+	{
+	case TOKEN_PHRASE:
+		return tables->nameOf(ResourceTables::Kind::AutoTranslate, id);
+	case TOKEN_ITEM:
+		return tables->nameOf(ResourceTables::Kind::Items, id);
+	default:
+		return std::string_view();
+	}
+}
+
+char *decodeInto(const char *src, const char *end, Profile profile, std::string &out, char *dst);
+
+// Output bytes per input byte at most: Json escapes ('\"') and transcodes
+// (half-width katakana is 3 bytes of UTF-8); the others only drop bytes
+inline size_t expansion(Profile profile)
+{
+	return (profile == Profile::Json) ? 3 : 1;
+}
+
+// Splice a resolved phrase into the output, decoded under the same profile.
+// out only has room reserved for the input, so grow it first.
+char *writePhrase(std::string_view phrase, Profile profile, size_t remaining, std::string &out, char *dst)
+{
+	size_t offset = static_cast<size_t>(dst - out.data());
+	size_t required = offset + (phrase.size() + remaining) * expansion(profile) + 2 + BLOCK;
+	if (required > out.size())
+	{
+		out.resize(required);
+		dst = &out[offset];
+	}
+
+	*dst++ = '{';
+	dst = decodeInto(phrase.data(), phrase.data() + phrase.size(), profile, out, dst);
+	*dst++ = '}';
+	return dst;
+}
+
+// Decode [src, end) to dst; out must have expansion(profile) bytes per input byte plus BLOCK of room from dst
+char *decodeInto(const char *src, const char *end, Profile profile, std::string &out, char *dst)
+{
+	const ByteRule *rules = rulesFor(profile);
+	const bool json = (profile == Profile::Json);
+
+	while (src < end)
+	{
+		// Fast path: copy plain ASCII a block at a time
+		while (end - src >= static_cast<ptrdiff_t>(BLOCK))
+		{
+			size_t run = plainRun(src, json);
+			copyBlock(dst, src);
+			dst += run;
+			src += run;
+			if (run < BLOCK)
+				break;
+		}
+		if (src >= end)
+			break;
+
+		// Slow path: one table entry for the byte that ended the run
+		ByteRule rule = rules[static_cast<unsigned char>(*src)];
+		size_t length = 1 + rule.params;
+		if (length > static_cast<size_t>(end - src))
+			length = static_cast<size_t>(end - src);
+
+		switch (rule.action)
+		{
+		case Action::Keep:
+			std::memcpy(dst, src, length);
+			dst += length;
+			break;
+		case Action::Escape:
+			*dst++ = '\\';
+			*dst++ = *src;
+			break;
+		case Action::Transcode:
+		{
+			uint32_t codePoint = (rule.params == 0) ? CP932::toCodePoint(static_cast<uint8_t>(src[0]))
+			                   : (length == 2)      ? CP932::toCodePoint(static_cast<uint8_t>(src[0]), static_cast<uint8_t>(src[1]))
+			                                        : 0;
+			if (codePoint == 0)
+			{
+				codePoint = CP932::REPLACEMENT;
+				// Do not swallow an ASCII byte behind a lead byte that does not pair with it
+				if (length == 2 && static_cast<unsigned char>(src[1]) < 0x80)
+					length = 1;
+			}
+			dst += CP932::encodeUtf8(codePoint, dst);
+			break;
+		}
+		case Action::Phrase:
+		{
+			// A lone 0xFD is dropped by itself; a complete token goes as a unit
+			if (static_cast<size_t>(end - src) < TOKEN_LENGTH || static_cast<uint8_t>(src[TOKEN_LENGTH - 1]) != 0xFD)
+				break;
+			length = TOKEN_LENGTH;
+			if (profile == Profile::Printable)
+				break;
+
+			std::string_view phrase = resolveToken(src);
+			if (!phrase.empty())
+				dst = writePhrase(phrase, profile, static_cast<size_t>(end - src), out, dst);
+			break;
+		}
+		case Action::Drop:
+			break;
+		}
+		src += length;
+	}
+
+	return dst;
+}
+
+} // namespace
+
+void setPhraseTable(const ResourceTables *tables)
+{
+	phraseTable.store(tables, std::memory_order_release);
+}
+
+const ByteRule *rulesFor(Profile profile)
+{
+	switch (profile)
+	{
+	case Profile::Chat:
+		return chatRules.data();
+	case Profile::Json:
+		return jsonRules.data();
+	case Profile::Printable:
+	default:
+		return printableRules.data();
+	}
+}
+
+void decode(std::string_view input, Profile profile, std::string &out)
+{
+	// Room for the worst case; the slack lets block stores overrun the logical end
+	const size_t start = out.size();
+	out.resize(start + input.size() * expansion(profile) + BLOCK);
+
+	char *dst = decodeInto(input.data(), input.data() + input.size(), profile, out, &out[start]);
+	out.resize(static_cast<size_t>(dst - out.data()));
+}
+
+std::string decode(std::string_view input, Profile profile)
+{
+	std::string out;
+	decode(input, profile, out);
+	return out;
+}
+
+} // namespace FFXIText
@@ -0,0 +1,295 @@
+#include "helpers/publisher.h"
+#include "helpers/http.h"
+#include <iostream>
+
+namespace {
+
+// A coalesced payload that failed or went stale is sent again after this long
+const std::chrono::milliseconds RETRY_DELAY(1000);
+
+} // namespace
+
+ChangePublisher::ChangePublisher()
+	: orderedSequence(0)
+	, running(false)
+	, maxStaleness(5000)
+	, requestTimeoutSeconds(10)
+	, enqueuedCount(0)
+	, coalescedCount(0)
+	, droppedCount(0)
+	, sentCount(0)
+	, failedCount(0)
+	, retriedCount(0)
+{
+}
+
+ChangePublisher::~ChangePublisher()
+{
+	stop();
+}
+
+void ChangePublisher::start()
+{
+	if (running)
+		return; // Already running
+
+	running = true;
+	publisherThread = std::thread(&ChangePublisher::publisherThreadFunc, this);
+}
+
+void ChangePublisher::stop()
+{
+	if (!running)
+		return; // Not running
+
+	{
+		std::lock_guard<std::mutex> lock(slotMutex);
+		running = false;
+	}
+	slotCondition.notify_all();
+
+	if (publisherThread.joinable())
+	{
+		publisherThread.join();
+	}
+
+	// Anything still pending will never be sent
+	std::lock_guard<std::mutex> lock(slotMutex);
+	droppedCount += readyQueue.size() + parkedSlots.size();
+	readyQueue.clear();
+	slots.clear();
+	parkedSlots.clear();
+}
+
+bool ChangePublisher::isRunning() const
+{
+	return running;
+}
+
+void ChangePublisher::setMaxStaleness(std::chrono::milliseconds staleness)
+{
+	std::lock_guard<std::mutex> lock(slotMutex);
+	maxStaleness = staleness;
+}
+
+void ChangePublisher::setRequestTimeout(long seconds)
+{
+	std::lock_guard<std::mutex> lock(slotMutex);
+	requestTimeoutSeconds = seconds;
+}
+
+void ChangePublisher::publish(DWORD procId, const std::string &key, const std::string &url, const std::string &jsonPayload)
+{
+	enqueue(SlotKey(procId, key), url, jsonPayload, std::string());
+}
+
+void ChangePublisher::publishOrdered(DWORD procId, const std::string &stream, const std::string &url, const std::string &jsonPayload)
+{
+	std::string key;
+	{
+		std::lock_guard<std::mutex> lock(slotMutex);
+		key = stream + "#" + std::to_string(++orderedSequence);
+	}
+	enqueue(SlotKey(procId, key), url, jsonPayload, stream);
+}
+
+void ChangePublisher::enqueue(const SlotKey &slotKey, const std::string &url, const std::string &jsonPayload, const std::string &stream)
+{
+	{
+		std::lock_guard<std::mutex> lock(slotMutex);
+		if (stream.empty())
+		{
+			// A newer value supersedes one waiting to be retried
+			parkedSlots.erase(slotKey);
+		}
+
+		Slot &slot = slots[slotKey];
+
+		slot.url = url;
+		slot.payload = jsonPayload;
+		slot.stream = stream;
+		slot.updatedAt = std::chrono::steady_clock::now();
+
+		if (slot.pending)
+		{
+			// Latest value wins - the queued entry will pick up the new payload
+			coalescedCount++;
+		}
+		else
+		{
+			slot.pending = true;
+			readyQueue.push_back(slotKey);
+		}
+	}
+
+	enqueuedCount++;
+	slotCondition.notify_one();
+}
+
+bool ChangePublisher::isLost(DWORD procId, const std::string &stream) const
+{
+	std::lock_guard<std::mutex> lock(slotMutex);
+	return lostStreams.count(SlotKey(procId, stream)) != 0;
+}
+
+bool ChangePublisher::takeLost(DWORD procId, const std::string &stream)
+{
+	std::lock_guard<std::mutex> lock(slotMutex);
+	return lostStreams.erase(SlotKey(procId, stream)) != 0;
+}
+
+ChangePublisher::Stats ChangePublisher::getStats() const
+{
+	Stats stats;
+	stats.enqueued = enqueuedCount;
+	stats.coalesced = coalescedCount;
+	stats.dropped = droppedCount;
+	stats.sent = sentCount;
+	stats.failed = failedCount;
+	stats.retried = retriedCount;
+	return stats;
+}
+
+size_t ChangePublisher::pendingCount() const
+{
+	std::lock_guard<std::mutex> lock(slotMutex);
+	return readyQueue.size();
+}
+
+void ChangePublisher::park(const SlotKey &slotKey, Slot &&slot)
+{
+	// Only if publish() hasn't queued a newer value for the slot meanwhile
+	if (slots.count(slotKey) != 0)
+	{
+		return;
+	}
+	if (parkedSlots.empty())
+	{
+		retryAt = std::chrono::steady_clock::now() + RETRY_DELAY;
+	}
+	parkedSlots[slotKey] = std::move(slot);
+}
+
+void ChangePublisher::requeueParked()
+{
+	auto now = std::chrono::steady_clock::now();
+	for (auto &parked : parkedSlots)
+	{
+		Slot &slot = slots[parked.first];
+		slot = std::move(parked.second);
+		slot.updatedAt = now;
+		slot.pending = true;
+		readyQueue.push_back(parked.first);
+		retriedCount++;
+	}
+	parkedSlots.clear();
+}
+
+void ChangePublisher::publisherThreadFunc()
+{
+	std::cout << "[Publisher] Publisher thread started" << std::endl;
+
+	// One client for the lifetime of the thread instead of one per change
+	HttpClient client;
+	client.setHeader("Content-Type", "application/json")
+	      .setHeader("Accept", "application/json");
+
+	while (true)
+	{
+		SlotKey slotKey;
+		Slot slot;
+		long timeoutSeconds = 0;
+
+		{
+			std::unique_lock<std::mutex> lock(slotMutex);
+			while (running && readyQueue.empty())
+			{
+				if (parkedSlots.empty())
+				{
+					slotCondition.wait(lock);
+				}
+				else if (slotCondition.wait_until(lock, retryAt) == std::cv_status::timeout)
+				{
+					requeueParked();
+				}
+			}
+
+			if (!running)
+			{
+				break;
+			}
+
+			slotKey = readyQueue.front();
+			readyQueue.pop_front();
+
+			auto slotIt = slots.find(slotKey);
+			if (slotIt == slots.end())
+			{
+				continue;
+			}
+
+			// Drained slots are removed so one-shot keys don't accumulate
+			slot = std::move(slotIt->second);
+			slots.erase(slotIt);
+
+			auto age = std::chrono::steady_clock::now() - slot.updatedAt;
+			if (maxStaleness.count() > 0 && age > maxStaleness)
+			{
+				if (slot.stream.empty())
+				{
+					// The only copy of the property's current value; fresher slots go first
+					park(slotKey, std::move(slot));
+				}
+				else
+				{
+					droppedCount++;
+					lostStreams.insert(SlotKey(slotKey.first, slot.stream));
+				}
+				continue;
+			}
+
+			timeoutSeconds = requestTimeoutSeconds;
+		}
+
+		bool delivered = false;
+		try
+		{
+			client.setTimeout(timeoutSeconds);
+			HttpClient::HttpResponse response = client.post(slot.url, slot.payload);
+
+			if (response.isSuccess())
+			{
+				sentCount++;
+				delivered = true;
+			}
+			else
+			{
+				failedCount++;
+				std::cout << "[Publisher] Failed to POST to " << slot.url << ". HTTP " << response.statusCode
+				          << ": " << response.body << std::endl;
+			}
+		}
+		catch (const std::exception &e)
+		{
+			failedCount++;
+			std::cout << "[Publisher] Error posting to " << slot.url << ": " << e.what() << std::endl;
+		}
+
+		if (!delivered)
+		{
+			// The owner has already taken this value as reported: retry a
+			// coalesced slot, have an ordered stream resynchronized
+			std::lock_guard<std::mutex> lock(slotMutex);
+			if (slot.stream.empty())
+			{
+				park(slotKey, std::move(slot));
+			}
+			else
+			{
+				lostStreams.insert(SlotKey(slotKey.first, slot.stream));
+			}
+		}
+	}
+
+	std::cout << "[Publisher] Publisher thread stopped" << std::endl;
+}
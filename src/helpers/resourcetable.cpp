@@ -0,0 +1,273 @@
+#include "helpers/resourcetable.h"
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+ResourceTables::ResourceTables()
+	: base(nullptr)
+	, size(0)
+	, header(nullptr)
+#ifdef _WIN32
+	, fileHandle(INVALID_HANDLE_VALUE)
+	, mappingHandle(nullptr)
+#else
+	, fileDescriptor(-1)
+#endif
+{
+}
+
+ResourceTables::~ResourceTables()
+{
+	close();
+}
+
+bool ResourceTables::open(const std::string &path)
+{
+	close();
+
+#ifdef _WIN32
+	fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(ResourceFormat::FileHeader)))
+	{
+		close();
+		return false;
+	}
+
+	mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle == nullptr)
+	{
+		close();
+		return false;
+	}
+
+	base = static_cast<const uint8_t *>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	size = static_cast<size_t>(fileSize.QuadPart);
+#else
+	fileDescriptor = ::open(path.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStat;
+	if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size < static_cast<off_t>(sizeof(ResourceFormat::FileHeader)))
+	{
+		close();
+		return false;
+	}
+
+	void *view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fileDescriptor, 0);
+	base = (view == MAP_FAILED) ? nullptr : static_cast<const uint8_t *>(view);
+	size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+	if (base == nullptr)
+	{
+		close();
+		return false;
+	}
+
+	header = reinterpret_cast<const ResourceFormat::FileHeader *>(base);
+	if (!validate())
+	{
+		std::cout << "[Resources] " << path << " is not a valid resource file" << std::endl;
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void ResourceTables::close()
+{
+#ifdef _WIN32
+	if (base)
+	{
+		UnmapViewOfFile(base);
+	}
+	if (mappingHandle)
+	{
+		CloseHandle(mappingHandle);
+		mappingHandle = nullptr;
+	}
+	if (fileHandle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(fileHandle);
+		fileHandle = INVALID_HANDLE_VALUE;
+	}
+#else
+	if (base)
+	{
+		munmap(const_cast<uint8_t *>(base), size);
+	}
+	if (fileDescriptor >= 0)
+	{
+		::close(fileDescriptor);
+		fileDescriptor = -1;
+	}
+#endif
+
+	base = nullptr;
+	size = 0;
+	header = nullptr;
+}
+
+bool ResourceTables::isOpen() const
+{
+	return header != nullptr;
+}
+
+bool ResourceTables::validate() const
+{
+	if (std::memcmp(header->magic, ResourceFormat::MAGIC, sizeof(header->magic)) != 0 ||
+	    header->version != ResourceFormat::VERSION ||
+	    header->fileSize != size)
+	{
+		return false;
+	}
+
+	auto inBounds = [this](uint64_t offset, uint64_t length) { return offset + length <= size; };
+
+	if (!inBounds(header->stringsOffset, header->stringsSize))
+	{
+		return false;
+	}
+
+	// Check every region once here so lookups can skip bounds checks
+	for (size_t i = 0; i < ResourceFormat::TABLE_COUNT; i++)
+	{
+		const ResourceFormat::TableHeader &t = header->tables[i];
+		uint64_t slotBytes = static_cast<uint64_t>(t.recordCount) * sizeof(uint32_t);
+		if (!inBounds(t.recordsOffset, static_cast<uint64_t>(t.recordCount) * sizeof(Record)) ||
+		    !inBounds(t.byId.displacementsOffset, static_cast<uint64_t>(t.byId.bucketCount) * sizeof(uint32_t)) ||
+		    !inBounds(t.byId.slotsOffset, slotBytes) ||
+		    !inBounds(t.byName.displacementsOffset, static_cast<uint64_t>(t.byName.bucketCount) * sizeof(uint32_t)) ||
+		    !inBounds(t.byName.slotsOffset, slotBytes) ||
+		    (t.recordCount > 0 && (t.byId.bucketCount == 0 || t.byName.bucketCount == 0)))
+		{
+			return false;
+		}
+
+		const Record *records = reinterpret_cast<const Record *>(base + t.recordsOffset);
+		const uint32_t *idSlots = words(t.byId.slotsOffset);
+		const uint32_t *nameSlots = words(t.byName.slotsOffset);
+		for (uint32_t r = 0; r < t.recordCount; r++)
+		{
+			if (idSlots[r] >= t.recordCount || nameSlots[r] >= t.recordCount ||
+			    records[r].nameOffset + static_cast<uint64_t>(records[r].nameLength) > header->stringsSize ||
+			    records[r].lowerNameOffset + static_cast<uint64_t>(records[r].nameLength) > header->stringsSize)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+const ResourceFormat::TableHeader *ResourceTables::table(Kind kind) const
+{
+	size_t index = static_cast<size_t>(kind);
+	if (!header || index >= ResourceFormat::TABLE_COUNT)
+	{
+		return nullptr;
+	}
+	return &header->tables[index];
+}
+
+const uint32_t *ResourceTables::words(uint32_t offset) const
+{
+	return reinterpret_cast<const uint32_t *>(base + offset);
+}
+
+const ResourceTables::Record *ResourceTables::lookup(const ResourceFormat::TableHeader &t, const ResourceFormat::PerfectHashIndex &index,
+                                                     const void *key, size_t keyLength) const
+{
+	if (t.recordCount == 0)
+	{
+		return nullptr;
+	}
+
+	uint32_t bucket = static_cast<uint32_t>(ResourceFormat::hash(key, keyLength, 0) % index.bucketCount);
+	uint32_t displacement = words(index.displacementsOffset)[bucket];
+	uint32_t slot = static_cast<uint32_t>(ResourceFormat::hash(key, keyLength, displacement) % t.recordCount);
+	uint32_t recordIndex = words(index.slotsOffset)[slot];
+	return reinterpret_cast<const Record *>(base + t.recordsOffset) + recordIndex;
+}
+
+const ResourceTables::Record *ResourceTables::findById(Kind kind, uint32_t id) const
+{
+	const ResourceFormat::TableHeader *t = table(kind);
+	if (!t)
+	{
+		return nullptr;
+	}
+
+	// Every key maps to some record; the compare rejects IDs that aren't in the table
+	const Record *record = lookup(*t, t->byId, &id, sizeof(id));
+	return (record && record->id == id) ? record : nullptr;
+}
+
+const ResourceTables::Record *ResourceTables::findByName(Kind kind, std::string_view name) const
+{
+	const ResourceFormat::TableHeader *t = table(kind);
+	if (!t)
+	{
+		return nullptr;
+	}
+
+	char lowered[256];
+	if (name.size() > sizeof(lowered))
+	{
+		return nullptr;
+	}
+	for (size_t i = 0; i < name.size(); i++)
+	{
+		lowered[i] = ResourceFormat::toLowerAscii(name[i]);
+	}
+
+	const Record *record = lookup(*t, t->byName, lowered, name.size());
+	if (!record || record->nameLength != name.size())
+	{
+		return nullptr;
+	}
+
+	const char *strings = reinterpret_cast<const char *>(base + header->stringsOffset);
+	return std::memcmp(strings + record->lowerNameOffset, lowered, name.size()) == 0 ? record : nullptr;
+}
+
+std::string_view ResourceTables::getName(const Record *record) const
+{
+	if (!record || !header)
+	{
+		return std::string_view();
+	}
+
+	const char *strings = reinterpret_cast<const char *>(base + header->stringsOffset);
+	return std::string_view(strings + record->nameOffset, record->nameLength);
+}
+
+std::string_view ResourceTables::nameOf(Kind kind, uint32_t id) const
+{
+	return getName(findById(kind, id));
+}
+
+size_t ResourceTables::getRecordCount(Kind kind) const
+{
+	const ResourceFormat::TableHeader *t = table(kind);
+	return t ? t->recordCount : 0;
+}
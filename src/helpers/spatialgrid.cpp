@@ -0,0 +1,288 @@
+#include "helpers/spatialgrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize, size_t capacity)
+	: cellSize(cellSize > 0.0f ? cellSize : 1.0f)
+	, inverseCellSize(1.0f / (cellSize > 0.0f ? cellSize : 1.0f))
+	, items(capacity)
+	, itemCount(0)
+{
+}
+
+namespace {
+
+const float CELL_LIMIT = 1073741824.0f;  // 2^30
+
+// Once a search has probed this many times more cells than are occupied,
+// scanning every item is cheaper than walking more empty cells
+const size_t EMPTY_CELL_FACTOR = 4;
+
+} // namespace
+
+int32_t SpatialGrid::cellCoord(float value) const
+{
+	float cell = std::floor(value * inverseCellSize);
+	if (!(cell > -CELL_LIMIT)) // Also catches NaN
+	{
+		return -static_cast<int32_t>(CELL_LIMIT);
+	}
+	if (cell > CELL_LIMIT)
+	{
+		return static_cast<int32_t>(CELL_LIMIT);
+	}
+	return static_cast<int32_t>(cell);
+}
+
+SpatialGrid::CellKey SpatialGrid::makeKey(int32_t cx, int32_t cy)
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+}
+
+void SpatialGrid::removeFromCell(uint32_t index)
+{
+	ItemState &item = items[index];
+	auto cellIt = cells.find(item.cell);
+	if (cellIt == cells.end())
+	{
+		return;
+	}
+
+	// Swap-remove, fixing up the moved item's back-reference
+	std::vector<uint32_t> &members = cellIt->second;
+	uint32_t last = members.back();
+	members[item.slotInCell] = last;
+	items[last].slotInCell = item.slotInCell;
+	members.pop_back();
+
+	if (members.empty())
+	{
+		cells.erase(cellIt);
+	}
+}
+
+bool SpatialGrid::update(uint32_t index, float x, float y)
+{
+	if (!std::isfinite(x) || !std::isfinite(y) || std::fabs(x) > MAX_COORDINATE || std::fabs(y) > MAX_COORDINATE)
+	{
+		remove(index);
+		return false;
+	}
+
+	if (index >= items.size())
+	{
+		items.resize(index + 1);
+	}
+
+	ItemState &item = items[index];
+	CellKey key = makeKey(cellCoord(x), cellCoord(y));
+	item.x = x;
+	item.y = y;
+
+	if (item.present)
+	{
+		if (item.cell == key)
+		{
+			return true; // Same cell - position updated in place
+		}
+		removeFromCell(index);
+	}
+	else
+	{
+		item.present = true;
+		itemCount++;
+	}
+
+	std::vector<uint32_t> &members = cells[key];
+	item.cell = key;
+	item.slotInCell = static_cast<uint32_t>(members.size());
+	members.push_back(index);
+	return true;
+}
+
+void SpatialGrid::remove(uint32_t index)
+{
+	if (index >= items.size() || !items[index].present)
+	{
+		return;
+	}
+
+	removeFromCell(index);
+	items[index].present = false;
+	itemCount--;
+}
+
+void SpatialGrid::clear()
+{
+	cells.clear();
+	for (ItemState &item : items)
+	{
+		item.present = false;
+	}
+	itemCount = 0;
+}
+
+bool SpatialGrid::contains(uint32_t index) const
+{
+	return index < items.size() && items[index].present;
+}
+
+size_t SpatialGrid::size() const
+{
+	return itemCount;
+}
+
+template <typename Fn>
+void SpatialGrid::forEachInRing(int32_t cx, int32_t cy, int32_t ring, Fn fn) const
+{
+	for (int32_t dy = -ring; dy <= ring; dy++)
+	{
+		// Interior rows only need the two edge cells
+		bool edgeRow = (dy == -ring || dy == ring);
+		int32_t step = edgeRow ? 1 : std::max(1, 2 * ring);
+		for (int32_t dx = -ring; dx <= ring; dx += step)
+		{
+			auto cellIt = cells.find(makeKey(cx + dx, cy + dy));
+			if (cellIt == cells.end())
+			{
+				continue;
+			}
+			for (uint32_t index : cellIt->second)
+			{
+				fn(index);
+			}
+		}
+	}
+}
+
+std::vector<uint32_t> SpatialGrid::queryRadius(float x, float y, float radius) const
+{
+	std::vector<uint32_t> result;
+	if (!(radius >= 0.0f) || !std::isfinite(x) || !std::isfinite(y))
+	{
+		return result;
+	}
+
+	float radiusSquared = radius * radius;
+	int32_t minX = cellCoord(x - radius);
+	int32_t maxX = cellCoord(x + radius);
+	int32_t minY = cellCoord(y - radius);
+	int32_t maxY = cellCoord(y + radius);
+
+	// A radius spanning far more cells than are occupied checks every item instead
+	double spanned = (double(maxX) - minX + 1) * (double(maxY) - minY + 1);
+	if (spanned > double(cells.size() * EMPTY_CELL_FACTOR))
+	{
+		for (const auto &cell : cells)
+		{
+			for (uint32_t index : cell.second)
+			{
+				float dx = items[index].x - x;
+				float dy = items[index].y - y;
+				if (dx * dx + dy * dy <= radiusSquared)
+				{
+					result.push_back(index);
+				}
+			}
+		}
+		return result;
+	}
+
+	for (int32_t cy = minY; cy <= maxY; cy++)
+	{
+		for (int32_t cx = minX; cx <= maxX; cx++)
+		{
+			auto cellIt = cells.find(makeKey(cx, cy));
+			if (cellIt == cells.end())
+			{
+				continue;
+			}
+			for (uint32_t index : cellIt->second)
+			{
+				float dx = items[index].x - x;
+				float dy = items[index].y - y;
+				if (dx * dx + dy * dy <= radiusSquared)
+				{
+					result.push_back(index);
+				}
+			}
+		}
+	}
+	return result;
+}
+
+std::vector<uint32_t> SpatialGrid::queryNearest(float x, float y, size_t k, uint32_t exclude) const
+{
+	std::vector<std::pair<float, uint32_t>> candidates;
+	if (k == 0 || itemCount == 0 || !std::isfinite(x) || !std::isfinite(y))
+	{
+		return std::vector<uint32_t>();
+	}
+
+	int32_t cx = cellCoord(x);
+	int32_t cy = cellCoord(y);
+	size_t visited = 0;
+	size_t available = itemCount - (contains(exclude) ? 1 : 0);
+	size_t probeLimit = cells.size() * EMPTY_CELL_FACTOR;
+
+	for (int32_t ring = 0; visited < available; ring++)
+	{
+		// Items far apart (or fewer than k reachable) would leave the rings
+		// walking empty cells; past the limit every remaining item is taken
+		size_t probed = size_t(2 * ring + 1) * size_t(2 * ring + 1);
+		if (probed > probeLimit)
+		{
+			candidates.clear();
+			for (const auto &cell : cells)
+			{
+				for (uint32_t index : cell.second)
+				{
+					if (index != exclude)
+					{
+						float dx = items[index].x - x;
+						float dy = items[index].y - y;
+						candidates.emplace_back(dx * dx + dy * dy, index);
+					}
+				}
+			}
+			break;
+		}
+
+		forEachInRing(cx, cy, ring, [&](uint32_t index) {
+			if (index == exclude)
+			{
+				return;
+			}
+			visited++;
+			float dx = items[index].x - x;
+			float dy = items[index].y - y;
+			candidates.emplace_back(dx * dx + dy * dy, index);
+		});
+
+		if (candidates.size() >= k)
+		{
+			// Anything outside this ring is at least `ring * cellSize` away
+			std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end());
+			float kthDistance = candidates[k - 1].first;
+			float ringDistance = static_cast<float>(ring) * cellSize;
+			if (kthDistance <= ringDistance * ringDistance)
+			{
+				break;
+			}
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end());
+	if (candidates.size() > k)
+	{
+		candidates.resize(k);
+	}
+
+	std::vector<uint32_t> result;
+	result.reserve(candidates.size());
+	for (const auto &candidate : candidates)
+	{
+		result.push_back(candidate.second);
+	}
+	return result;
+}
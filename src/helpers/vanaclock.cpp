@@ -0,0 +1,134 @@
+#include "helpers/vanaclock.h"
+#include <cstdlib>
+#include <iostream>
+
+VanaClock::VanaClock()
+	: correctionSeconds(0)
+	, verified(false)
+{
+}
+
+uint64_t VanaClock::toRawSeconds(std::chrono::system_clock::time_point earthTime)
+{
+	// Millisecond precision, so Vana'diel seconds (40ms of Earth time) don't alias
+	int64_t earthMs = std::chrono::duration_cast<std::chrono::milliseconds>(earthTime.time_since_epoch()).count();
+	int64_t elapsedMs = earthMs - EARTH_EPOCH_UNIX * 1000;
+	return VANA_EPOCH_SECONDS + static_cast<uint64_t>(elapsedMs * TIME_SCALE / 1000);
+}
+
+uint64_t VanaClock::fromClientSeconds(uint32_t clientSeconds)
+{
+	return VANA_EPOCH_SECONDS + static_cast<uint64_t>(clientSeconds) * TIME_SCALE;
+}
+
+VanaClock::VanaTime VanaClock::fromRawSeconds(uint64_t rawSeconds)
+{
+	VanaTime time;
+	time.rawSeconds = rawSeconds;
+
+	uint64_t totalDays = rawSeconds / SECONDS_PER_DAY;
+	uint64_t secondOfDay = rawSeconds % SECONDS_PER_DAY;
+
+	time.year = static_cast<uint32_t>(totalDays / DAYS_PER_YEAR);
+	uint32_t dayOfYear = static_cast<uint32_t>(totalDays % DAYS_PER_YEAR);
+	time.month = dayOfYear / DAYS_PER_MONTH + 1;
+	time.day = dayOfYear % DAYS_PER_MONTH + 1;
+	time.hour = static_cast<uint32_t>(secondOfDay / 3600);
+	time.minute = static_cast<uint32_t>((secondOfDay % 3600) / 60);
+	time.second = static_cast<uint32_t>(secondOfDay % 60);
+	time.weekday = static_cast<Weekday>(totalDays % 8);
+
+	// 84-day cycle: 0% at cycle day 0, 100% at day 42; each of the 12 phases spans 7 days centred on its peak
+	uint32_t cycleDay = static_cast<uint32_t>((totalDays + MOON_CYCLE_OFFSET) % MOON_CYCLE_DAYS);
+	uint32_t half = MOON_CYCLE_DAYS / 2;
+	uint32_t distanceFromFull = (cycleDay > half) ? cycleDay - half : half - cycleDay;
+	time.moonPercent = 100 - (distanceFromFull * 100 + half / 2) / half;
+	time.moonPhase = static_cast<MoonPhase>(((cycleDay + 3) / 7) % 12);
+	return time;
+}
+
+VanaClock::VanaTime VanaClock::now() const
+{
+	return at(std::chrono::system_clock::now());
+}
+
+VanaClock::VanaTime VanaClock::at(std::chrono::system_clock::time_point earthTime) const
+{
+	int64_t raw = static_cast<int64_t>(toRawSeconds(earthTime)) + correctionSeconds.load();
+	return fromRawSeconds(static_cast<uint64_t>(raw > 0 ? raw : 0));
+}
+
+bool VanaClock::verify(uint64_t observedRawSeconds, std::chrono::system_clock::time_point observedAt)
+{
+	int64_t computed = static_cast<int64_t>(toRawSeconds(observedAt));
+	int64_t difference = static_cast<int64_t>(observedRawSeconds) - computed;
+	bool agreed = std::llabs(difference) <= VERIFY_TOLERANCE_SECONDS;
+
+	// Skew is seconds to minutes; anything this far off is a bad read, not a clock
+	if (std::llabs(difference) > MAX_CORRECTION_SECONDS)
+	{
+		std::cout << "[VanaClock] Client reading is off by " << difference
+		          << " Vana'diel seconds; ignoring it and keeping the computed clock" << std::endl;
+		return false;
+	}
+
+	if (agreed)
+	{
+		std::cout << "[VanaClock] Verified against client (off by " << difference << " Vana'diel seconds)" << std::endl;
+	}
+	else
+	{
+		std::cout << "[VanaClock] Computed clock is off by " << difference
+		          << " Vana'diel seconds; applying correction" << std::endl;
+	}
+
+	correctionSeconds = difference;
+	verified = true;
+	return agreed;
+}
+
+bool VanaClock::isVerified() const
+{
+	return verified;
+}
+
+int64_t VanaClock::getCorrectionSeconds() const
+{
+	return correctionSeconds;
+}
+
+const char *VanaClock::weekdayName(Weekday weekday)
+{
+	switch (weekday)
+	{
+		case Weekday::Firesday: return "Firesday";
+		case Weekday::Earthsday: return "Earthsday";
+		case Weekday::Watersday: return "Watersday";
+		case Weekday::Windsday: return "Windsday";
+		case Weekday::Iceday: return "Iceday";
+		case Weekday::Lightningday: return "Lightningday";
+		case Weekday::Lightsday: return "Lightsday";
+		case Weekday::Darksday: return "Darksday";
+		default: return "Unknown";
+	}
+}
+
+const char *VanaClock::moonPhaseName(MoonPhase phase)
+{
+	switch (phase)
+	{
+		case MoonPhase::New: return "New Moon";
+		case MoonPhase::WaxingCrescent:
+		case MoonPhase::WaxingCrescent2: return "Waxing Crescent";
+		case MoonPhase::FirstQuarter: return "First Quarter";
+		case MoonPhase::WaxingGibbous:
+		case MoonPhase::WaxingGibbous2: return "Waxing Gibbous";
+		case MoonPhase::Full: return "Full Moon";
+		case MoonPhase::WaningGibbous:
+		case MoonPhase::WaningGibbous2: return "Waning Gibbous";
+		case MoonPhase::LastQuarter: return "Last Quarter";
+		case MoonPhase::WaningCrescent:
+		case MoonPhase::WaningCrescent2: return "Waning Crescent";
+		default: return "Unknown";
+	}
+}
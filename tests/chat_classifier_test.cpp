@@ -0,0 +1,135 @@
+// Differential check: ChatClassifier against the regex list it replaced
+// (regex_reference.h). Lines no addition matches must classify exactly
+// as the original list did; lines an addition matches are checked
+// against the list with the additions inserted, and a few fixed lines pin
+// each addition's type. Lines come from the synthetic corpus and from a
+// seeded generator that glues together the tokens the grammar cares
+// about, so the edges of every pattern (missing closers, blanks on
+// either side, stray arrows) are hit many times over.
+
+#include "Player/ChatClassifier.h"
+#include "helpers/ffxitext.h"
+#include "regex_reference.h"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Random line built from grammar tokens, names, words and blanks
+std::string generateLine(std::mt19937& rng)
+{
+    static const char* const tokens[] = {
+        "(", ")", "()", "<", ">", "<>", ">>", ">>>", " >> ", "[1]<", "[2]<", "[1]", "[3]<", "{", "}", "{}", "{3}",
+        "You>>", "You >>", "You find a", "You find", "obtains a", "obtains", "Obtained key item:", "Obtained",
+        ":", " : ", " :", ": ", "says", "shouts", "yells", " says:", " shouts :", " yells  :", "'",
+        "Piplup", "Ayame", "Zeid", "O'Hara", "Trial", "1234", "7", "[Jeuno]", "hello", "pull",
+        " ", "  ", "\t", "\r", "\x81\x40", "\x82\xa0", "\xfd", "\x7f",
+    };
+    const size_t tokenCount = sizeof(tokens) / sizeof(tokens[0]);
+
+    std::string line;
+    size_t count = 1 + rng() % 8;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (rng() % 10 == 0)
+        {
+            line += static_cast<char>('a' + rng() % 26);
+        }
+        else
+        {
+            line += tokens[rng() % tokenCount];
+        }
+    }
+    return line;
+}
+
+const char* typeName(ChatMessageType type)
+{
+    return getChatMessageTypeString(type);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* corpusPath = argc > 1 ? argv[1] : CHAT_CORPUS;
+    const size_t generated = argc > 2 ? std::stoul(argv[2]) : 300000;
+
+    const std::vector<RegexReference::Pattern> original = RegexReference::patterns();
+    const std::vector<RegexReference::Addition> additions = RegexReference::additions();
+    const std::vector<RegexReference::Pattern> extended = RegexReference::withAdditions();
+    size_t checked = 0;
+    size_t checkedAdditions = 0;
+    size_t mismatches = 0;
+
+    auto expect = [&](const std::string& line, ChatMessageType expected, const char* oracle) {
+        ChatMessageType actual = ChatClassifier::classify(line);
+        if (expected != actual && ++mismatches <= 20)
+        {
+            std::printf("MISMATCH \"%s\": %s %s, classifier %s\n", line.c_str(), oracle, typeName(expected), typeName(actual));
+        }
+    };
+
+    auto check = [&](const std::string& line) {
+        checked++;
+        if (RegexReference::matchesAddition(additions, line))
+        {
+            checkedAdditions++;
+            expect(line, RegexReference::classify(extended, line), "additions");
+        }
+        else
+        {
+            expect(line, RegexReference::classify(original, line), "regex");
+        }
+    };
+
+    // The additions by themselves, including where they give way to the original list
+    const struct {
+        const char* line;
+        ChatMessageType type;
+    } fixed[] = {
+        {"<Zeid> pull in 5", ChatMessageType::Linkshell1},
+        {"  <Zeid> pull in 5", ChatMessageType::Linkshell1},
+        {"[2]<Zeid> pull in 5", ChatMessageType::Linkshell2},
+        {"(Ayame) <Zeid> hi", ChatMessageType::Party},
+        {"Piplup says: hello", ChatMessageType::Say},
+        {"Piplup says : hello", ChatMessageType::Say},
+        {"Piplup shouts: WTS", ChatMessageType::Shout},
+        {"Piplup yells : LFG", ChatMessageType::Yell},
+        {"Piplup : says: hello", ChatMessageType::Say},
+        {"Piplup yells (loudly): hi", ChatMessageType::Party},
+    };
+    for (const auto& entry : fixed)
+    {
+        expect(entry.line, entry.type, "fixed");
+        expect(entry.line, RegexReference::classify(extended, entry.line), "additions");
+    }
+
+    std::ifstream corpus(corpusPath, std::ios::binary);
+    if (!corpus)
+    {
+        std::printf("Cannot open corpus %s\n", corpusPath);
+        return 1;
+    }
+    std::string raw;
+    std::string line;
+    while (std::getline(corpus, raw))
+    {
+        // Classified the way the chat sources see it: control codes stripped
+        line.clear();
+        FFXIText::decode(raw, FFXIText::Profile::Chat, line);
+        check(line);
+    }
+
+    std::mt19937 rng(20260419);
+    for (size_t i = 0; i < generated; i++)
+    {
+        check(generateLine(rng));
+    }
+
+    std::printf("%zu lines checked (%zu against the additions), %zu mismatches\n", checked, checkedAdditions, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
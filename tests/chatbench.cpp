@@ -0,0 +1,204 @@
+// Chat engine benchmark over the synthetic corpus. Reports lines/s and
+// heap allocations per line for the regex list ChatLogProperty used to
+// run (regex_reference.h), for ChatClassifier, and for the whole path a
+// raw line takes through ffxichat: FFXIText decode, ChatParser::parse,
+// then ChatBatch append/trimTo as the chat sources retain it. The
+// sjis stages convert the decoded (mixed Japanese/English) lines to
+// UTF-8 the old two-step way (cp932_reference.h) and with CP932; the
+// text stages run the raw lines through the per-byte cleanup loops
+// FFXIText replaced and through FFXIText::decode.
+//
+// Usage: chatbench [corpus] [passes]
+
+#include "Player/ChatBatch.h"
+#include "Player/ChatClassifier.h"
+#include "Player/ChatParser.h"
+#include "helpers/cp932.h"
+#include "helpers/ffxitext.h"
+#include "cp932_reference.h"
+#include "regex_reference.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<size_t> allocationCount(0);
+
+} // namespace
+
+// Every heap allocation in the process goes through here. GCC flags the
+// free() below once these are inlined next to a new-expression, although
+// malloc and free are exactly what the replacements pair up
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size)
+{
+    allocationCount++;
+    if (void* block = std::malloc(size ? size : 1))
+    {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept
+{
+    std::free(block);
+}
+
+void operator delete(void* block, size_t) noexcept
+{
+    std::free(block);
+}
+
+namespace {
+
+const size_t BATCH_LIMIT = 100;  // Messages Player keeps between flushes
+
+// The loops FFXIText::decode replaced: EliteAPI's printable-ASCII filter
+// and its JSON escaping lambda
+void oldPrintable(const std::string& line, std::string& out)
+{
+    for (const char* p = line.c_str(); *p; p++)
+    {
+        char c = *p;
+        if (c >= 32 && c <= 126)
+        {
+            out += c;
+        }
+    }
+}
+
+std::string oldEscapeJson(const std::string& s)
+{
+    std::string out;
+    for (char c : s)
+    {
+        if (c == '"') out += "\\\"";
+        else if (c == '\\') out += "\\\\";
+        else if (c == '\b') out += "\\b";
+        else if (c == '\f') out += "\\f";
+        else if (c == '\n') out += "\\n";
+        else if (c == '\r') out += "\\r";
+        else if (c == '\t') out += "\\t";
+        else out += c;
+    }
+    return out;
+}
+
+std::vector<std::string> loadCorpus(const char* path)
+{
+    std::vector<std::string> lines;
+    std::ifstream corpus(path, std::ios::binary);
+    std::string raw;
+    while (std::getline(corpus, raw))
+    {
+        lines.push_back(raw);
+    }
+    return lines;
+}
+
+// Run fn over every line `passes` times and print lines/s and allocations/line
+template <typename Fn>
+void run(const char* name, const std::vector<std::string>& lines, size_t passes, Fn fn)
+{
+    size_t checksum = 0;
+    size_t allocationsBefore = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t pass = 0; pass < passes; pass++)
+    {
+        for (const std::string& line : lines)
+        {
+            checksum += static_cast<size_t>(fn(line));
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double allocations = double(allocationCount - allocationsBefore);
+    double total = double(lines.size()) * double(passes);
+    std::printf("%-12s %12.0f lines/s  %8.3f allocations/line  (%.0f lines, %.3f s, checksum %zu)\n",
+                name, total / seconds, allocations / total, total, seconds, checksum);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* corpusPath = argc > 1 ? argv[1] : CHAT_CORPUS;
+    const size_t passes = argc > 2 ? std::stoul(argv[2]) : 20;
+
+    const std::vector<std::string> rawLines = loadCorpus(corpusPath);
+    if (rawLines.empty())
+    {
+        std::printf("Cannot read corpus %s\n", corpusPath);
+        return 1;
+    }
+
+    // The classifiers see lines the way the chat sources hand them over
+    std::vector<std::string> lines;
+    for (const std::string& raw : rawLines)
+    {
+        lines.push_back(FFXIText::decode(raw, FFXIText::Profile::Chat));
+    }
+
+    const std::vector<RegexReference::Pattern> patterns = RegexReference::patterns();
+    run("regex", lines, passes, [&patterns](const std::string& line) {
+        return RegexReference::classify(patterns, line);
+    });
+    run("classifier", lines, passes, [](const std::string& line) {
+        return ChatClassifier::classify(line);
+    });
+
+    std::string text;
+    run("text-old", rawLines, passes, [&text](const std::string& raw) {
+        text.clear();
+        oldPrintable(raw, text);
+        return text.size();
+    });
+    run("text", rawLines, passes, [&text](const std::string& raw) {
+        text.clear();
+        FFXIText::decode(raw, FFXIText::Profile::Printable, text);
+        return text.size();
+    });
+    run("json-old", lines, passes, [](const std::string& line) {
+        return oldEscapeJson(line).size();
+    });
+    run("json", lines, passes, [](const std::string& line) {
+        return FFXIText::decode(line, FFXIText::Profile::Json).size();
+    });
+
+    run("sjis-2step", lines, passes, [](const std::string& line) {
+        return CP932Reference::toUtf8(line).size();
+    });
+    run("sjis-toUtf8", lines, passes, [](const std::string& line) {
+        return CP932::toUtf8(line).size();
+    });
+    std::string utf8;
+    CP932::Decoder decoder;
+    run("sjis-decoder", lines, passes, [&utf8, &decoder](const std::string& line) {
+        utf8.clear();
+        decoder.decode(line, utf8);
+        decoder.finish(utf8);
+        return utf8.size();
+    });
+
+    // Reused across lines like the chat sources' own buffers
+    std::string decoded;
+    ChatBatch batch;
+    run("pipeline", rawLines, passes, [&decoded, &batch](const std::string& raw) {
+        decoded.clear();
+        FFXIText::decode(raw, FFXIText::Profile::Chat, decoded);
+        ChatMessageView view = ChatParser::parse(decoded);
+        batch.append(view);
+        batch.trimTo(BATCH_LIMIT);
+        return view.message.size();
+    });
+    return 0;
+}
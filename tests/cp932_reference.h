@@ -0,0 +1,86 @@
+#pragma once
+
+#include "helpers/cp932.h"
+#include <string>
+#include <string_view>
+
+/**
+ * Shift-JIS to UTF-8 the way ShiftJISToUTF8 did it before CP932: size and
+ * convert to UTF-16, then size and convert to UTF-8, one byte at a time
+ * with a wide-string intermediate. It uses the same tables and the same
+ * rules for bytes with no mapping as CP932::Decoder, so it is the oracle
+ * for cp932_test and the baseline for chatbench.
+ */
+namespace CP932Reference {
+
+// UTF-16 form of input; counts only when out is null
+inline size_t toUtf16(std::string_view input, char16_t* out)
+{
+    size_t count = 0;
+    size_t i = 0;
+    while (i < input.size())
+    {
+        uint8_t byte = static_cast<uint8_t>(input[i++]);
+        uint32_t codePoint;
+        if (byte < 0x80)
+        {
+            codePoint = byte;
+        }
+        else if (CP932::isLeadByte(byte))
+        {
+            codePoint = CP932::REPLACEMENT;
+            if (i < input.size())
+            {
+                uint8_t trail = static_cast<uint8_t>(input[i]);
+                uint32_t pair = CP932::toCodePoint(byte, trail);
+                if (pair != 0)
+                {
+                    codePoint = pair;
+                    i++;
+                }
+                else if (trail >= 0x80)
+                {
+                    i++;  // An unmapped pair swallows a non-ASCII trail
+                }
+            }
+        }
+        else
+        {
+            codePoint = CP932::toCodePoint(byte);
+            if (codePoint == 0)
+            {
+                codePoint = CP932::REPLACEMENT;
+            }
+        }
+
+        if (out)
+        {
+            out[count] = static_cast<char16_t>(codePoint);
+        }
+        count++;
+    }
+    return count;
+}
+
+inline std::string toUtf8(std::string_view input)
+{
+    std::u16string wide(toUtf16(input, nullptr), u'\0');
+    toUtf16(input, &wide[0]);
+
+    char buffer[3];
+    size_t length = 0;
+    for (char16_t unit : wide)
+    {
+        length += CP932::encodeUtf8(unit, buffer);
+    }
+
+    std::string out(length, '\0');
+    char* dst = &out[0];
+    for (char16_t unit : wide)
+    {
+        dst += CP932::encodeUtf8(unit, dst);
+    }
+    return out;
+}
+
+} // namespace CP932Reference
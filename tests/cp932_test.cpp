@@ -0,0 +1,137 @@
+// CP932 transcoder check. Every corpus line and a set of seeded random
+// buffers (long ASCII runs for the SIMD copy, lead bytes with good and
+// bad trails, bytes with no mapping) are converted whole with
+// CP932::toUtf8 and compared with the byte-at-a-time reference
+// (cp932_reference.h); each buffer is then fed to a CP932::Decoder in
+// random chunks, so lead bytes land on chunk boundaries, and the
+// concatenated output must match the whole-buffer result.
+//
+// Usage: cp932_test [corpus] [buffers]
+
+#include "helpers/cp932.h"
+#include "cp932_reference.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string generateBuffer(std::mt19937& rng)
+{
+    std::string buffer;
+    size_t pieces = 1 + rng() % 40;
+    for (size_t i = 0; i < pieces; i++)
+    {
+        switch (rng() % 6)
+        {
+            case 0:
+            {
+                // ASCII run, often longer than a SIMD block
+                size_t run = rng() % 80;
+                for (size_t j = 0; j < run; j++)
+                {
+                    buffer += static_cast<char>(0x20 + rng() % 0x5F);
+                }
+                break;
+            }
+            case 1:
+            {
+                // Mapped pair (hiragana / kanji rows)
+                static const uint8_t leads[] = {0x82, 0x83, 0x88, 0x93, 0x95, 0xE0, 0xEA};
+                buffer += static_cast<char>(leads[rng() % sizeof(leads)]);
+                buffer += static_cast<char>(0x40 + rng() % 0xBD);
+                break;
+            }
+            case 2:
+                // Lead byte followed by anything, including ASCII and another lead
+                buffer += static_cast<char>(0x81 + rng() % 0x1F);
+                buffer += static_cast<char>(rng() % 256);
+                break;
+            case 3:
+                // Half-width katakana and single bytes with no mapping
+                buffer += static_cast<char>(0xA0 + rng() % 0x60);
+                break;
+            default:
+                buffer += static_cast<char>(rng() % 256);
+                break;
+        }
+    }
+    if (rng() % 4 == 0)
+    {
+        buffer += static_cast<char>(0xE0 + rng() % 0x1D);  // Truncated final lead
+    }
+    return buffer;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* corpusPath = argc > 1 ? argv[1] : CHAT_CORPUS;
+    const size_t generated = argc > 2 ? std::stoul(argv[2]) : 50000;
+
+    std::mt19937 rng(20260419);
+    size_t checked = 0;
+    size_t mismatches = 0;
+
+    auto report = [&mismatches](const char* what, const std::string& input) {
+        if (++mismatches <= 20)
+        {
+            std::printf("MISMATCH (%s) on %zu-byte input:", what, input.size());
+            for (unsigned char byte : input)
+            {
+                std::printf(" %02X", byte);
+            }
+            std::printf("\n");
+        }
+    };
+
+    auto check = [&](const std::string& input) {
+        checked++;
+        std::string whole = CP932::toUtf8(input);
+        if (whole != CP932Reference::toUtf8(input))
+        {
+            report("whole buffer", input);
+            return;
+        }
+
+        CP932::Decoder decoder;
+        std::string chunked;
+        size_t offset = 0;
+        while (offset < input.size())
+        {
+            size_t length = rng() % 5 == 0 ? 0 : 1 + rng() % 48;
+            length = std::min(length, input.size() - offset);
+            decoder.decode(std::string_view(input).substr(offset, length), chunked);
+            offset += length;
+        }
+        decoder.finish(chunked);
+        if (chunked != whole)
+        {
+            report("chunked", input);
+        }
+    };
+
+    std::ifstream corpus(corpusPath, std::ios::binary);
+    if (!corpus)
+    {
+        std::printf("Cannot open corpus %s\n", corpusPath);
+        return 1;
+    }
+    std::string line;
+    while (std::getline(corpus, line))
+    {
+        check(line);
+    }
+
+    for (size_t i = 0; i < generated; i++)
+    {
+        check(generateBuffer(rng));
+    }
+
+    std::printf("%zu buffers checked, %zu mismatches\n", checked, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
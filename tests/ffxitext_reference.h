@@ -0,0 +1,88 @@
+#pragma once
+
+#include "helpers/cp932.h"
+#include "helpers/ffxitext.h"
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+/**
+ * FFXIText::decode written out one byte at a time from the rules in
+ * ffxitext.h, with no rule table and no block copies. No phrase table is
+ * loaded, so every complete auto-translate token is dropped whole. The
+ * oracle for ffxitext_test.
+ */
+namespace FFXITextReference {
+
+inline std::string decode(std::string_view input, FFXIText::Profile profile)
+{
+    std::string out;
+    size_t i = 0;
+    while (i < input.size())
+    {
+        uint8_t byte = static_cast<uint8_t>(input[i]);
+        size_t remaining = input.size() - i;
+
+        // Control codes, the same in every profile
+        if (byte <= 0x1D || byte == 0x80 || byte == 0xA0 || byte >= 0xFE)
+        {
+            i++;
+            continue;
+        }
+        if (byte == 0x1E || byte == 0x1F || byte == 0x7F)
+        {
+            i += std::min<size_t>(2, remaining);
+            continue;
+        }
+        if (byte == 0xFD)
+        {
+            bool token = remaining >= 6 && static_cast<uint8_t>(input[i + 5]) == 0xFD;
+            i += token ? 6 : 1;
+            continue;
+        }
+
+        if (byte < 0x80)
+        {
+            if (profile == FFXIText::Profile::Json && (byte == '"' || byte == '\\'))
+            {
+                out += '\\';
+            }
+            out += static_cast<char>(byte);
+            i++;
+            continue;
+        }
+
+        // Shift-JIS: a lead byte owns the byte after it
+        size_t length = CP932::isLeadByte(byte) ? std::min<size_t>(2, remaining) : 1;
+        if (profile == FFXIText::Profile::Chat)
+        {
+            out.append(input.substr(i, length));
+        }
+        else if (profile == FFXIText::Profile::Json)
+        {
+            uint32_t codePoint = 0;
+            if (!CP932::isLeadByte(byte))
+            {
+                codePoint = CP932::toCodePoint(byte);
+            }
+            else if (length == 2)
+            {
+                codePoint = CP932::toCodePoint(byte, static_cast<uint8_t>(input[i + 1]));
+            }
+            if (codePoint == 0)
+            {
+                codePoint = CP932::REPLACEMENT;
+                if (length == 2 && static_cast<uint8_t>(input[i + 1]) < 0x80)
+                {
+                    length = 1;
+                }
+            }
+            char buffer[3];
+            out.append(buffer, CP932::encodeUtf8(codePoint, buffer));
+        }
+        i += length;
+    }
+    return out;
+}
+
+} // namespace FFXITextReference
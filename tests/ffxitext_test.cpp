@@ -0,0 +1,130 @@
+// Differential check: FFXIText::decode, with whichever block copy it was
+// built with (AVX2, SSE2 or the scalar loop), against the byte-at-a-time
+// reference (ffxitext_reference.h) in every profile. Inputs are the
+// corpus lines and seeded random buffers that put control codes, quotes,
+// Shift-JIS pairs and auto-translate tokens at every offset around long
+// plain runs, so each block boundary is crossed many times. Output is
+// appended to a non-empty string, as the callers that reuse buffers do.
+//
+// Usage: ffxitext_test [corpus] [buffers]
+
+#include "helpers/ffxitext.h"
+#include "ffxitext_reference.h"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace {
+
+std::string generateBuffer(std::mt19937& rng)
+{
+    std::string buffer;
+    size_t pieces = 1 + rng() % 24;
+    for (size_t i = 0; i < pieces; i++)
+    {
+        switch (rng() % 8)
+        {
+            case 0:
+            case 1:
+            {
+                // Plain run, up to a few blocks long
+                size_t run = rng() % 100;
+                for (size_t j = 0; j < run; j++)
+                {
+                    buffer += static_cast<char>(0x20 + rng() % 0x5F);
+                }
+                break;
+            }
+            case 2:
+                buffer += (rng() % 2) ? '"' : '\\';
+                break;
+            case 3:
+                // Colour code or client marker, sometimes the last byte
+                buffer += static_cast<char>((rng() % 3 == 0) ? 0x7F : 0x1E + rng() % 2);
+                if (rng() % 4)
+                {
+                    buffer += static_cast<char>(rng() % 256);
+                }
+                break;
+            case 4:
+            {
+                // Auto-translate token, complete or cut short
+                static const char token[] = "\xFD\x02\x02\x0B\x2A\xFD";
+                buffer.append(token, 1 + rng() % 6);
+                break;
+            }
+            case 5:
+                // Shift-JIS pair; the trail may be ASCII
+                buffer += static_cast<char>((rng() % 2) ? 0x82 + rng() % 8 : 0xE0 + rng() % 0x1D);
+                buffer += static_cast<char>(0x40 + rng() % 0xBD);
+                break;
+            default:
+                buffer += static_cast<char>(rng() % 256);
+                break;
+        }
+    }
+    return buffer;
+}
+
+const char* profileName(FFXIText::Profile profile)
+{
+    switch (profile)
+    {
+        case FFXIText::Profile::Printable: return "Printable";
+        case FFXIText::Profile::Chat: return "Chat";
+        default: return "Json";
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* corpusPath = argc > 1 ? argv[1] : CHAT_CORPUS;
+    const size_t generated = argc > 2 ? std::stoul(argv[2]) : 100000;
+
+    const FFXIText::Profile profiles[] = {FFXIText::Profile::Printable, FFXIText::Profile::Chat, FFXIText::Profile::Json};
+    const std::string prefix = "prefix:";
+    size_t checked = 0;
+    size_t mismatches = 0;
+
+    auto check = [&](const std::string& input) {
+        for (FFXIText::Profile profile : profiles)
+        {
+            checked++;
+            std::string actual = prefix;
+            FFXIText::decode(input, profile, actual);
+            if (actual != prefix + FFXITextReference::decode(input, profile) && ++mismatches <= 20)
+            {
+                std::printf("MISMATCH (%s) on %zu-byte input:", profileName(profile), input.size());
+                for (unsigned char byte : input)
+                {
+                    std::printf(" %02X", byte);
+                }
+                std::printf("\n");
+            }
+        }
+    };
+
+    std::ifstream corpus(corpusPath, std::ios::binary);
+    if (!corpus)
+    {
+        std::printf("Cannot open corpus %s\n", corpusPath);
+        return 1;
+    }
+    std::string line;
+    while (std::getline(corpus, line))
+    {
+        check(line);
+    }
+
+    std::mt19937 rng(20260419);
+    for (size_t i = 0; i < generated; i++)
+    {
+        check(generateBuffer(rng));
+    }
+
+    std::printf("%zu decodes checked, %zu mismatches\n", checked, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
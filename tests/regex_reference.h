@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Player/ChatMessage.h"
+#include <regex>
+#include <string>
+#include <vector>
+
+/**
+ * The chat classifier as it was before ChatClassifier. patterns() is the
+ * list ChatLogProperty ran with std::regex_search, copied verbatim and in
+ * its original priority order; it is the oracle for chat_classifier_test
+ * and the baseline for chatbench. additions() holds the forms
+ * ChatClassifier learned later, when the EliteAPI and log sources began
+ * sharing it (bare "<Name>" linkshell lines and "Name says/shouts/yells:"),
+ * each with the place in the original list where classify() checks it.
+ */
+namespace RegexReference {
+
+struct Pattern {
+    std::regex pattern;
+    ChatMessageType type;
+};
+
+struct Addition {
+    Pattern pattern;
+    size_t before;  // Index in patterns() this is checked ahead of
+};
+
+inline std::vector<Pattern> patterns()
+{
+    std::vector<Pattern> list;
+    auto add = [&list](const char* expression, ChatMessageType type) {
+        list.push_back({std::regex(expression), type});
+    };
+
+    add("^\\s*\\([^)]+\\)", ChatMessageType::Party);
+    add("^\\s*You>>", ChatMessageType::Tell);
+    add("^\\s*[^>]+>>", ChatMessageType::Tell);
+    add("^\\s*>>[^\\s]", ChatMessageType::Tell);
+    add("\\[1\\]<", ChatMessageType::Linkshell1);
+    add("\\[2\\]<", ChatMessageType::Linkshell2);
+    add("\\([^)]+\\)", ChatMessageType::Party);
+    add("[^>]+>>", ChatMessageType::Tell);
+    add(">>[^\\s]", ChatMessageType::Tell);
+    add("^\\s*\\{[^}]*[A-Za-z][^}]*\\}", ChatMessageType::Unity);
+    add("^\\s*[A-Za-z]+'?[A-Za-z]*\\s+:\\s+", ChatMessageType::Say);
+    add("You find a", ChatMessageType::Drops);
+    add("obtains a", ChatMessageType::Obtained);
+    add("^Obtained key item:", ChatMessageType::Obtained);
+    add("^[A-Za-z]+\\s+\\d+:", ChatMessageType::Trial);
+    return list;
+}
+
+inline std::vector<Addition> additions()
+{
+    std::vector<Addition> list;
+    auto add = [&list](const char* expression, ChatMessageType type, size_t before) {
+        list.push_back({{std::regex(expression), type}, before});
+    };
+
+    add("^\\s*<[^>]+>", ChatMessageType::Linkshell1, 6);  // EliteAPI "<Name> Message"
+    add("^\\s*[A-Za-z]+\\s+says\\s*:", ChatMessageType::Say, 11);  // Log file forms
+    add("^\\s*[A-Za-z]+\\s+shouts\\s*:", ChatMessageType::Shout, 11);
+    add("^\\s*[A-Za-z]+\\s+yells\\s*:", ChatMessageType::Yell, 11);
+    return list;
+}
+
+// The original list with the additions inserted where classify() checks them
+inline std::vector<Pattern> withAdditions()
+{
+    const std::vector<Pattern> original = patterns();
+    const std::vector<Addition> added = additions();
+    std::vector<Pattern> list;
+    for (size_t i = 0; i <= original.size(); i++)
+    {
+        for (const Addition& addition : added)
+        {
+            if (addition.before == i)
+            {
+                list.push_back(addition.pattern);
+            }
+        }
+        if (i < original.size())
+        {
+            list.push_back(original[i]);
+        }
+    }
+    return list;
+}
+
+inline ChatMessageType classify(const std::vector<Pattern>& patterns, const std::string& line)
+{
+    for (const Pattern& pattern : patterns)
+    {
+        if (std::regex_search(line, pattern.pattern))
+        {
+            return pattern.type;
+        }
+    }
+    return ChatMessageType::Unknown;
+}
+
+// Whether any of the additions matches line
+inline bool matchesAddition(const std::vector<Addition>& additions, const std::string& line)
+{
+    for (const Addition& addition : additions)
+    {
+        if (std::regex_search(line, addition.pattern.pattern))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace RegexReference
@@ -0,0 +1,291 @@
+// Build-time generator for the memory-mapped game-data file.
+//
+// Usage: resgen <input-dir> <output-file>
+//
+// <input-dir> may contain items.tsv, spells.tsv, abilities.tsv,
+// zones.tsv and autotranslate.tsv; missing files produce empty tables.
+// Each line is
+//   id<TAB>name[<TAB>attribute0[<TAB>attribute1]]
+// and lines starting with '#' are ignored. Auto-translate IDs are
+// category * 256 + index and the name is the phrase text. Names are
+// stored in the client's encoding (Shift-JIS for the Japanese client). See includes/helpers/resourceformat.h
+// for the output layout.
+
+#include "helpers/resourceformat.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct InputRow {
+	uint32_t id;
+	std::string name;
+	uint32_t attributes[2];
+};
+
+struct BuiltTable {
+	std::vector<ResourceFormat::Record> records;
+	std::vector<uint32_t> idDisplacements;
+	std::vector<uint32_t> idSlots;
+	std::vector<uint32_t> nameDisplacements;
+	std::vector<uint32_t> nameSlots;
+};
+
+struct Key {
+	std::string bytes;
+	uint32_t recordIndex;
+};
+
+const char *TABLE_FILES[ResourceFormat::TABLE_COUNT] = {"items.tsv", "spells.tsv", "abilities.tsv", "zones.tsv", "autotranslate.tsv"};
+
+bool readRows(const std::string &path, std::vector<InputRow> &rows)
+{
+	std::ifstream file(path);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	std::string line;
+	size_t lineNumber = 0;
+	while (std::getline(file, line))
+	{
+		lineNumber++;
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		std::vector<std::string> fields;
+		std::stringstream stream(line);
+		std::string field;
+		while (std::getline(stream, field, '\t'))
+			fields.push_back(field);
+
+		if (fields.size() < 2 || fields[1].empty())
+		{
+			std::cerr << path << ":" << lineNumber << ": expected id<TAB>name" << std::endl;
+			continue;
+		}
+
+		InputRow row;
+		row.id = static_cast<uint32_t>(std::strtoul(fields[0].c_str(), nullptr, 10));
+		row.name = fields[1];
+		row.attributes[0] = fields.size() > 2 ? static_cast<uint32_t>(std::strtoul(fields[2].c_str(), nullptr, 10)) : 0;
+		row.attributes[1] = fields.size() > 3 ? static_cast<uint32_t>(std::strtoul(fields[3].c_str(), nullptr, 10)) : 0;
+		rows.push_back(row);
+	}
+	return true;
+}
+
+// Hash-and-displace: place the largest buckets first, searching for a seed
+// that sends every key in the bucket to a distinct free slot.
+bool buildPerfectHash(const std::vector<Key> &keys, uint32_t slotCount,
+                      std::vector<uint32_t> &displacements, std::vector<uint32_t> &slots)
+{
+	uint32_t bucketCount = std::max<uint32_t>(1, static_cast<uint32_t>((keys.size() + 3) / 4));
+	displacements.assign(bucketCount, 0);
+	slots.assign(slotCount, 0);
+	if (keys.empty())
+	{
+		return true;
+	}
+
+	std::vector<std::vector<size_t>> buckets(bucketCount);
+	for (size_t k = 0; k < keys.size(); k++)
+	{
+		uint64_t h = ResourceFormat::hash(keys[k].bytes.data(), keys[k].bytes.size(), 0);
+		buckets[h % bucketCount].push_back(k);
+	}
+
+	std::vector<uint32_t> order(bucketCount);
+	for (uint32_t b = 0; b < bucketCount; b++)
+		order[b] = b;
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return buckets[a].size() > buckets[b].size(); });
+
+	std::vector<bool> taken(slotCount, false);
+	std::vector<uint32_t> candidate;
+	for (uint32_t b : order)
+	{
+		const std::vector<size_t> &bucket = buckets[b];
+		if (bucket.empty())
+			break;
+
+		bool placed = false;
+		for (uint32_t seed = 1; seed < 10000000 && !placed; seed++)
+		{
+			candidate.clear();
+			bool collision = false;
+			for (size_t k : bucket)
+			{
+				uint32_t slot = static_cast<uint32_t>(ResourceFormat::hash(keys[k].bytes.data(), keys[k].bytes.size(), seed) % slotCount);
+				if (taken[slot] || std::find(candidate.begin(), candidate.end(), slot) != candidate.end())
+				{
+					collision = true;
+					break;
+				}
+				candidate.push_back(slot);
+			}
+			if (collision)
+				continue;
+
+			for (size_t i = 0; i < bucket.size(); i++)
+			{
+				taken[candidate[i]] = true;
+				slots[candidate[i]] = keys[bucket[i]].recordIndex;
+			}
+			displacements[b] = seed;
+			placed = true;
+		}
+
+		if (!placed)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool buildTable(std::vector<InputRow> rows, std::string &strings, BuiltTable &out, const char *tableName)
+{
+	std::sort(rows.begin(), rows.end(), [](const InputRow &a, const InputRow &b) { return a.id < b.id; });
+
+	std::vector<Key> idKeys;
+	std::vector<Key> nameKeys;
+	std::map<std::string, uint32_t> seenNames;
+
+	for (size_t i = 0; i < rows.size(); i++)
+	{
+		const InputRow &row = rows[i];
+		if (i > 0 && rows[i - 1].id == row.id)
+		{
+			std::cerr << tableName << ": duplicate ID " << row.id << std::endl;
+			return false;
+		}
+
+		std::string lower = row.name;
+		std::transform(lower.begin(), lower.end(), lower.begin(), ResourceFormat::toLowerAscii);
+
+		ResourceFormat::Record record;
+		record.id = row.id;
+		record.nameOffset = static_cast<uint32_t>(strings.size());
+		record.nameLength = static_cast<uint32_t>(row.name.size());
+		strings += row.name;
+		record.lowerNameOffset = static_cast<uint32_t>(strings.size());
+		strings += lower;
+		record.attributes[0] = row.attributes[0];
+		record.attributes[1] = row.attributes[1];
+
+		uint32_t recordIndex = static_cast<uint32_t>(out.records.size());
+		out.records.push_back(record);
+
+		idKeys.push_back(Key{std::string(reinterpret_cast<const char *>(&row.id), sizeof(row.id)), recordIndex});
+
+		// Several items share a name; the lowest ID wins the name index
+		if (seenNames.emplace(lower, recordIndex).second)
+		{
+			nameKeys.push_back(Key{lower, recordIndex});
+		}
+	}
+
+	uint32_t slotCount = static_cast<uint32_t>(out.records.size());
+	if (!buildPerfectHash(idKeys, slotCount, out.idDisplacements, out.idSlots) ||
+	    !buildPerfectHash(nameKeys, slotCount, out.nameDisplacements, out.nameSlots))
+	{
+		std::cerr << tableName << ": failed to build perfect hash" << std::endl;
+		return false;
+	}
+
+	std::cout << tableName << ": " << out.records.size() << " records, " << nameKeys.size() << " distinct names" << std::endl;
+	return true;
+}
+
+void align4(std::vector<uint8_t> &buffer)
+{
+	while (buffer.size() % 4)
+		buffer.push_back(0);
+}
+
+template <typename T>
+uint32_t append(std::vector<uint8_t> &buffer, const T *data, size_t count)
+{
+	align4(buffer);
+	uint32_t offset = static_cast<uint32_t>(buffer.size());
+	const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data);
+	buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+	return offset;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	if (argc != 3)
+	{
+		std::cerr << "Usage: resgen <input-dir> <output-file>" << std::endl;
+		return 1;
+	}
+
+	std::string inputDir = argv[1];
+	std::string outputPath = argv[2];
+
+	std::string strings;
+	BuiltTable tables[ResourceFormat::TABLE_COUNT];
+	for (size_t i = 0; i < ResourceFormat::TABLE_COUNT; i++)
+	{
+		std::vector<InputRow> rows;
+		std::string path = inputDir + "/" + TABLE_FILES[i];
+		if (!readRows(path, rows))
+		{
+			std::cout << TABLE_FILES[i] << " not found, writing an empty table" << std::endl;
+		}
+		if (!buildTable(rows, strings, tables[i], TABLE_FILES[i]))
+		{
+			return 1;
+		}
+	}
+
+	ResourceFormat::FileHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, ResourceFormat::MAGIC, sizeof(header.magic));
+	header.version = ResourceFormat::VERSION;
+
+	std::vector<uint8_t> buffer(sizeof(header), 0);
+	for (size_t i = 0; i < ResourceFormat::TABLE_COUNT; i++)
+	{
+		const BuiltTable &t = tables[i];
+		ResourceFormat::TableHeader &th = header.tables[i];
+		th.recordCount = static_cast<uint32_t>(t.records.size());
+		th.recordsOffset = append(buffer, t.records.data(), t.records.size());
+		th.byId.bucketCount = static_cast<uint32_t>(t.idDisplacements.size());
+		th.byId.displacementsOffset = append(buffer, t.idDisplacements.data(), t.idDisplacements.size());
+		th.byId.slotsOffset = append(buffer, t.idSlots.data(), t.idSlots.size());
+		th.byName.bucketCount = static_cast<uint32_t>(t.nameDisplacements.size());
+		th.byName.displacementsOffset = append(buffer, t.nameDisplacements.data(), t.nameDisplacements.size());
+		th.byName.slotsOffset = append(buffer, t.nameSlots.data(), t.nameSlots.size());
+	}
+
+	header.stringsOffset = append(buffer, strings.data(), strings.size());
+	header.stringsSize = static_cast<uint32_t>(strings.size());
+	align4(buffer);
+	header.fileSize = static_cast<uint32_t>(buffer.size());
+	std::memcpy(buffer.data(), &header, sizeof(header));
+
+	std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+	if (!output.is_open())
+	{
+		std::cerr << "Cannot write " << outputPath << std::endl;
+		return 1;
+	}
+	output.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+	std::cout << "Wrote " << buffer.size() << " bytes to " << outputPath << std::endl;
+	return 0;
+}